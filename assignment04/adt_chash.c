@@ -0,0 +1,355 @@
+#include <stdlib.h> // malloc
+#include <string.h> // memcpy, memcmp
+
+#include "adt_chash.h"
+
+#define CHASH_INIT_BITS	10	// 처음 슬롯 수 1024
+#define CHASH_MAX_BITS	30
+#define CHASH_CHUNK		1024	// 크기 변경 때 한 스레드가 한 번에 가져가서 옮기는 슬롯 수
+
+// 해시값을 섞어서 상위 bits 비트를 시작 위치로 사용 (fibonacci hashing, adt_hash 와 같음)
+static size_t _home( CTABLE *pTable, unsigned int hash){
+    return (size_t)((hash * 2654435769u) >> (32 - pTable -> bits));
+}
+
+// FNV-1a
+static unsigned int _hash( const char *word, int len){
+    unsigned int hash = 2166136261u;
+
+    for(int i = 0; i < len; i++){
+        hash ^= (unsigned char)word[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 슬롯의 단어가 찾는 단어인지 확인 (해시값으로 먼저 거름)
+static int _match( const CWORD *pWord, const char *word, int len, unsigned int hash){
+    return pWord -> hash == hash && pWord -> len == len && memcmp(pWord -> word, word, len) == 0;
+}
+
+// Allocates a word structure (freq = 1)
+// return	NULL if overflow
+static CWORD *_createWord( const char *word, int len, unsigned int hash){
+    CWORD *pWord = malloc(sizeof(CWORD) + len + 1);
+    if(pWord == NULL) return NULL;
+
+    atomic_init(&pWord -> freq, 1);
+    pWord -> hash = hash;
+    pWord -> len = len;
+    memcpy(pWord -> word, word, len);
+    pWord -> word[len] = '\0';
+
+    return pWord;
+}
+
+// Allocates an empty table with 2^bits slots
+// return	NULL if overflow
+static CTABLE *_createTable( int bits, CTABLE *prev){
+    CTABLE *pTable = malloc(sizeof(CTABLE));
+    if(pTable == NULL) return NULL;
+
+    pTable -> slots = calloc((size_t)1 << bits, sizeof(pTable -> slots[0]));
+    if(pTable -> slots == NULL){
+        free(pTable);
+        return NULL;
+    }
+
+    pTable -> bits = bits;
+    pTable -> capacity = (size_t)1 << bits;
+    atomic_init(&pTable -> used, 0);
+    atomic_init(&pTable -> next, NULL);
+    atomic_init(&pTable -> claim, 0);
+    atomic_init(&pTable -> moved, 0);
+    pTable -> prev = prev;
+
+    return pTable;
+}
+
+static void _destroyTable( CTABLE *pTable){
+    free(pTable -> slots);
+    free(pTable);
+}
+
+// 옮기기가 끝난 테이블을 지나 pHash -> table 을 앞으로 보냄
+// 나중 테이블의 옮기기가 먼저 끝날 수도 있으므로 끝난 테이블이 이어지는 동안 계속 진행
+static void _advance( CHASH *pHash){
+    CTABLE *pTable = atomic_load_explicit(&pHash -> table, memory_order_acquire);
+
+    while(1){
+        CTABLE *next = atomic_load_explicit(&pTable -> next, memory_order_acquire);
+
+        if(next == NULL || atomic_load_explicit(&pTable -> moved, memory_order_acquire) != pTable -> capacity) return;
+
+        // 실패하면 pTable 에 다른 스레드가 바꾼 현재 테이블이 들어옴
+        if(atomic_compare_exchange_strong_explicit(&pHash -> table, &pTable, next, memory_order_acq_rel, memory_order_acquire)){
+            pTable = next;
+        }
+    }
+}
+
+static CTABLE *_grow( CHASH *pHash, CTABLE *pTable);
+
+// 옛 테이블의 단어를 새 테이블에 배치 (키가 새 테이블에 없다고 가정)
+// 같은 단어 구조체를 그대로 넣으므로 freq 는 옮기지 않아도 됨
+// return	1 success
+//			0 if overflow (새 테이블이 가득 찼는데 더 큰 테이블을 만들지 못함)
+static int _place( CHASH *pHash, CTABLE *pTable, CWORD *pWord){
+    while(pTable != NULL){
+        size_t mask = pTable -> capacity - 1;
+        size_t i = _home(pTable, pWord -> hash);
+
+        for(size_t probes = 0; probes < pTable -> capacity; ){
+            uintptr_t v = 0;
+
+            if(atomic_compare_exchange_strong_explicit(&pTable -> slots[i], &v, (uintptr_t)pWord, memory_order_acq_rel, memory_order_acquire)){
+                atomic_fetch_add_explicit(&pTable -> used, 1, memory_order_relaxed);
+                return 1;
+            }
+            if(v == CHASH_MOVED) break;
+
+            i = (i + 1) & mask;
+            probes++;
+        }
+        // 이 테이블도 옮기는 중(또는 가득 참): 돕고 다음 테이블에 배치
+        pTable = _grow(pHash, pTable);
+    }
+    return 0;
+}
+
+// 크기 변경 돕기
+// 아직 아무도 가져가지 않은 슬롯을 CHASH_CHUNK 개씩 가져가서 옮김
+//	빈 슬롯	CHASH_MOVED 로 막음 (이후 이 슬롯에 오는 삽입은 새 테이블로 감)
+//	단어	새 테이블에 배치 (빈 슬롯을 막는 CAS 가 실패하면 방금 들어온 단어)
+// 가져갈 슬롯이 없으면 다른 스레드가 옮기는 중이라도 바로 돌아감
+// 옮기지 않은 키는 옛 테이블에서 먼저 찾게 되므로 새 테이블에 같은 키가 두 번 들어가지 않음
+// return	1 success
+//			0 if overflow (단어를 새 테이블에 배치하지 못함, pHash -> lost = 1)
+static int _migrate( CHASH *pHash, CTABLE *pTable){
+    CTABLE *next = atomic_load_explicit(&pTable -> next, memory_order_acquire);
+    size_t start;
+
+    while((start = atomic_fetch_add_explicit(&pTable -> claim, CHASH_CHUNK, memory_order_relaxed)) < pTable -> capacity){
+        size_t end = start + CHASH_CHUNK < pTable -> capacity ? start + CHASH_CHUNK : pTable -> capacity;
+
+        for(size_t i = start; i < end; i++){
+            uintptr_t v = 0;
+
+            if(atomic_compare_exchange_strong_explicit(&pTable -> slots[i], &v, CHASH_MOVED, memory_order_acq_rel, memory_order_acquire)) continue;
+
+            // 옮기지 못한 단어는 옛 테이블에만 남으므로 이 테이블의 옮기기는 끝나지 않음 (pHash -> table 이 여기서 멈춤)
+            if(!_place(pHash, next, (CWORD *)v)){
+                atomic_store_explicit(&pHash -> lost, 1, memory_order_relaxed);
+                return 0;
+            }
+        }
+
+        if(atomic_fetch_add_explicit(&pTable -> moved, end - start, memory_order_acq_rel) + (end - start) == pTable -> capacity){
+            _advance(pHash);
+        }
+    }
+    return 1;
+}
+
+// 테이블 크기 변경을 시작하거나(새 테이블을 next 에 CAS) 진행 중인 크기 변경을 도움
+// return	다음 테이블
+//			NULL if overflow (새 테이블을 만들지 못했거나 옮기는 중 단어를 배치하지 못함)
+static CTABLE *_grow( CHASH *pHash, CTABLE *pTable){
+    CTABLE *next = atomic_load_explicit(&pTable -> next, memory_order_acquire);
+
+    if(next == NULL){
+        if(pTable -> bits >= CHASH_MAX_BITS) return NULL;
+
+        CTABLE *fresh = _createTable(pTable -> bits + 1, pTable);
+        if(fresh == NULL) return NULL;
+
+        // 실패하면 next 에 다른 스레드가 건 테이블이 들어옴
+        if(atomic_compare_exchange_strong_explicit(&pTable -> next, &next, fresh, memory_order_acq_rel, memory_order_acquire)){
+            next = fresh;
+        }
+        else{
+            _destroyTable(fresh);
+        }
+    }
+
+    if(!_migrate(pHash, pTable)) return NULL;
+
+    return next;
+}
+
+// used in destroyCHash
+// 옮긴 단어 pWord 가 테이블에 있는지 확인 (pointer 비교, 빈 슬롯이나 막힌 슬롯을 만나면 없음)
+// 단어는 배치될 때 탐사 경로의 첫 빈 슬롯에 들어가므로 그 앞의 슬롯은 모두 채워져 있음
+static int _contains( CTABLE *pTable, CWORD *pWord){
+    size_t mask = pTable -> capacity - 1;
+    size_t i = _home(pTable, pWord -> hash);
+
+    for(size_t probes = 0; probes < pTable -> capacity; probes++){
+        uintptr_t v = atomic_load_explicit(&pTable -> slots[i], memory_order_relaxed);
+
+        if(v == (uintptr_t)pWord) return 1;
+        if(v <= CHASH_MOVED) return 0;
+
+        i = (i + 1) & mask;
+    }
+    return 0;
+}
+
+// 가장 최근 테이블 (크기 변경이 모두 끝난 뒤에는 모든 단어를 가짐)
+static CTABLE *_last( CHASH *pHash){
+    CTABLE *pTable = atomic_load_explicit(&pHash -> table, memory_order_acquire);
+    CTABLE *next;
+
+    while((next = atomic_load_explicit(&pTable -> next, memory_order_acquire)) != NULL){
+        pTable = next;
+    }
+    return pTable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Allocates dynamic memory for a concurrent counting hash table
+// return	head pointer
+// 			NULL if overflow
+CHASH *createCHash( void){
+    CHASH *pHash = malloc(sizeof(CHASH));
+    if(pHash == NULL) return NULL;
+
+    CTABLE *pTable = _createTable(CHASH_INIT_BITS, NULL);
+    if(pTable == NULL){
+        free(pHash);
+        return NULL;
+    }
+
+    atomic_init(&pHash -> table, pTable);
+    atomic_init(&pHash -> count, 0);
+    atomic_init(&pHash -> lost, 0);
+
+    return pHash;
+}
+
+// 해시 테이블에 할당된 메모리를 해제 (head, tables, words)
+// 다른 스레드가 모두 끝난 뒤 호출
+// 옮긴 단어는 여러 테이블에 있으므로 오래된 테이블부터 보며 뒤 테이블에 없는 단어만 해제
+// (옮기기가 모두 끝났으면 가장 최근 테이블에서만 해제, overflow 로 옮기지 못한 단어도 해제)
+void destroyCHash( CHASH *pHash){
+    CTABLE *pTable = _last(pHash);
+
+    while(pTable -> prev != NULL){
+        pTable = pTable -> prev;
+    }
+
+    for(CTABLE *cur = pTable; cur != NULL; cur = atomic_load_explicit(&cur -> next, memory_order_relaxed)){
+        for(size_t i = 0; i < cur -> capacity; i++){
+            uintptr_t v = atomic_load_explicit(&cur -> slots[i], memory_order_relaxed);
+            int later = 0;
+
+            if(v <= CHASH_MOVED) continue;
+
+            for(CTABLE *t = atomic_load_explicit(&cur -> next, memory_order_relaxed); t != NULL && !later; t = atomic_load_explicit(&t -> next, memory_order_relaxed)){
+                later = _contains(t, (CWORD *)v);
+            }
+            if(!later) free((CWORD *)v);
+        }
+    }
+
+    while(pTable != NULL){
+        CTABLE *next = atomic_load_explicit(&pTable -> next, memory_order_relaxed);
+
+        _destroyTable(pTable);
+        pTable = next;
+    }
+    free(pHash);
+}
+
+// Counts a word (여러 스레드에서 동시에 호출 가능)
+// 빈 슬롯을 만나면 새 단어를 CAS 로 넣고, CAS 가 실패하면 같은 슬롯에 들어온 단어부터 다시 비교
+// 막힌 슬롯(CHASH_MOVED)을 만나면 크기 변경을 돕고 새 테이블에서 다시 찾음
+//	return	0 if overflow (단어를 세지 못했거나, 크기 변경 중 다른 단어를 새 테이블로 옮기지 못함)
+//			1 if new word (freq = 1)
+//			2 if duplicated key (freq 증가)
+int addCHash( CHASH *pHash, const char *word, int len){
+    unsigned int hash = _hash(word, len);
+    CWORD *pNew = NULL;
+    CTABLE *pTable = atomic_load_explicit(&pHash -> table, memory_order_acquire);
+
+    while(pTable != NULL){
+        size_t mask = pTable -> capacity - 1;
+        size_t i = _home(pTable, hash);
+
+        for(size_t probes = 0; probes < pTable -> capacity; ){
+            uintptr_t v = atomic_load_explicit(&pTable -> slots[i], memory_order_acquire);
+
+            if(v == 0){
+                if(pNew == NULL){
+                    pNew = _createWord(word, len, hash);
+                    if(pNew == NULL) return 0;
+                }
+                if(atomic_compare_exchange_strong_explicit(&pTable -> slots[i], &v, (uintptr_t)pNew, memory_order_acq_rel, memory_order_acquire)){
+                    atomic_fetch_add_explicit(&pHash -> count, 1, memory_order_relaxed);
+
+                    // load factor 1/2 을 넘으면 두 배로 늘림 (linear probing 이므로 adt_hash 보다 낮게)
+                    // 새 테이블을 만들지 못한 것은 괜찮지만 (지금 테이블을 계속 씀) 옮기다 단어를 잃으면 overflow
+                    if((atomic_fetch_add_explicit(&pTable -> used, 1, memory_order_relaxed) + 1) * 2 > pTable -> capacity){
+                        if(_grow(pHash, pTable) == NULL && atomic_load_explicit(&pHash -> lost, memory_order_relaxed)) return 0;
+                    }
+                    return 1;
+                }
+                continue;
+            }
+            if(v == CHASH_MOVED) break;
+
+            if(_match((CWORD *)v, word, len, hash)){
+                atomic_fetch_add_explicit(&((CWORD *)v) -> freq, 1, memory_order_relaxed);
+                free(pNew);
+                return 2;
+            }
+            i = (i + 1) & mask;
+            probes++;
+        }
+        pTable = _grow(pHash, pTable);
+    }
+
+    free(pNew);
+    return 0;
+}
+
+// interface to search function (여러 스레드에서 동시에 호출 가능)
+//	return	word structure pointer
+//			NULL not found
+CWORD *searchCHash( CHASH *pHash, const char *word, int len){
+    unsigned int hash = _hash(word, len);
+    CTABLE *pTable = atomic_load_explicit(&pHash -> table, memory_order_acquire);
+
+    while(pTable != NULL){
+        size_t mask = pTable -> capacity - 1;
+        size_t i = _home(pTable, hash);
+
+        for(size_t probes = 0; probes < pTable -> capacity; probes++){
+            uintptr_t v = atomic_load_explicit(&pTable -> slots[i], memory_order_acquire);
+
+            if(v == 0) return NULL;
+            if(v == CHASH_MOVED) break;
+            if(_match((CWORD *)v, word, len, hash)) return (CWORD *)v;
+
+            i = (i + 1) & mask;
+        }
+        pTable = atomic_load_explicit(&pTable -> next, memory_order_acquire);
+    }
+    return NULL;
+}
+
+// returns number of words in hash table
+int countCHash( CHASH *pHash){
+    return atomic_load_explicit(&pHash -> count, memory_order_relaxed);
+}
+
+// traverses words in slot order (순서 없음, 다른 스레드가 모두 끝난 뒤 호출)
+void traverseCHash( CHASH *pHash, void (*callback)(const CWORD *)){
+    CTABLE *pTable = _last(pHash);
+
+    for(size_t i = 0; i < pTable -> capacity; i++){
+        uintptr_t v = atomic_load_explicit(&pTable -> slots[i], memory_order_relaxed);
+
+        if(v > CHASH_MOVED) callback((CWORD *)v);
+    }
+}
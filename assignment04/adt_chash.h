@@ -0,0 +1,77 @@
+#ifndef ADT_CHASH_H
+#define ADT_CHASH_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uintptr_t
+#include <stdatomic.h> // _Atomic
+
+////////////////////////////////////////////////////////////////////////////////
+// CHASH type definition
+// 여러 스레드가 락 없이 함께 단어를 세는 open addressing (linear probing) 해시 테이블
+//	이미 있는 단어	freq 를 atomic 으로 1 증가 (addNode 가 2 를 돌려주는 경우의 freq++ 에 해당)
+//	새 단어		빈 슬롯에 CAS 로 단어 pointer 를 넣음 (지는 스레드는 그 슬롯의 단어를 다시 비교)
+//	크기 변경	2배 크기의 새 테이블을 next 에 걸고, 테이블을 쓰는 스레드들이 슬롯을 CHASH_CHUNK 개씩
+//				나누어 옮김 (빈 슬롯은 CHASH_MOVED 로 막고 단어 pointer 만 새 테이블에 다시 배치)
+// 단어 구조체는 테이블이 바뀌어도 그대로이므로 옮기는 중에도 freq 증가가 사라지지 않음
+// 삭제는 지원하지 않음 (병렬로 사전을 만드는 용도)
+typedef struct
+{
+	atomic_int		freq;	// 빈도
+	unsigned int	hash;	// 단어의 해시값
+	int				len;	// 단어 길이 ('\0' 제외)
+	char			word[];	// '\0' 포함
+} CWORD;
+
+// 슬롯 값: 0 (비어 있음), CHASH_MOVED (비어 있던 채로 새 테이블로 옮겨짐), 그 외 CWORD pointer
+#define CHASH_MOVED	((uintptr_t)1)
+
+typedef struct ctable
+{
+	int			bits;		// log2(capacity)
+	size_t		capacity;	// 슬롯 수 (2의 거듭제곱)
+	atomic_size_t	used;	// 채워진 슬롯 수 (capacity 의 절반을 넘으면 크기 변경)
+	_Atomic(uintptr_t)	*slots;
+	_Atomic(struct ctable *)	next;	// 옮겨 갈 새 테이블 (NULL if 크기 변경 전)
+	atomic_size_t	claim;	// 다음에 옮길 슬롯 index (CHASH_CHUNK 개씩 가져감)
+	atomic_size_t	moved;	// 옮기기를 마친 슬롯 수
+	struct ctable	*prev;	// 이전 테이블 (destroyCHash 에서 해제)
+} CTABLE;
+
+typedef struct
+{
+	_Atomic(CTABLE *)	table;	// 옮기기가 끝난 가장 최근 테이블 (검색 시작 위치)
+	atomic_int	count;	// 서로 다른 단어 수
+	atomic_int	lost;	// 1 if 크기 변경 중 단어를 새 테이블에 옮기지 못함 (overflow, 이후 traverse 에서 빠질 수 있음)
+} CHASH;
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+// Allocates dynamic memory for a concurrent counting hash table
+// return	head pointer
+// 			NULL if overflow
+CHASH *createCHash( void);
+
+// 해시 테이블에 할당된 메모리를 해제 (head, tables, words)
+// 다른 스레드가 모두 끝난 뒤 호출
+void destroyCHash( CHASH *pHash);
+
+// Counts a word (여러 스레드에서 동시에 호출 가능)
+//	word, len	단어 (len 바이트, '\0' 으로 끝나지 않아도 됨)
+//	return	0 if overflow (단어를 세지 못했거나, 크기 변경 중 다른 단어를 새 테이블로 옮기지 못함)
+//			1 if new word (freq = 1)
+//			2 if duplicated key (freq 증가)
+int addCHash( CHASH *pHash, const char *word, int len);
+
+// interface to search function (여러 스레드에서 동시에 호출 가능)
+//	return	word structure pointer
+//			NULL not found
+CWORD *searchCHash( CHASH *pHash, const char *word, int len);
+
+// returns number of words in hash table
+int countCHash( CHASH *pHash);
+
+// traverses words in slot order (순서 없음, 다른 스레드가 모두 끝난 뒤 호출)
+void traverseCHash( CHASH *pHash, void (*callback)(const CWORD *));
+
+#endif
@@ -2,16 +2,101 @@
 
 #include "adt_dlist.h"
 
+// skip list 에서 노드 x 다음의 높이 i + 2 노드 (x == NULL 이면 head)
+#define SKIP_NEXT( pList, x, i)	((x) != NULL ? (x) -> skip[i] : (pList) -> skipHead[i])
+
+// internal compare function
+// 키의 prefix 가 노드의 prefix 와 다르면 정수 비교만으로 결정하고, 같을 때만 compare 호출
+// prefix 함수가 없는 리스트는 모든 prefix 가 0 이므로 항상 compare 를 호출
+// for _search function
+static inline int _compare( LIST *pList, void *pArgu, uint64_t keyPrefix, NODE *node){
+    if(keyPrefix != node -> prefix){
+        return keyPrefix < node -> prefix ? -1 : 1;
+    }
+    return pList -> compare(pArgu, node -> dataPtr);
+}
+
+// internal function
+// 새 노드의 skip list 높이를 정함 (각 층으로 올라갈 확률 1/4)
+// for _insert function
+static int _random_level( LIST *pList){
+    int level = 1;
+
+    // xorshift32
+    pList -> seed ^= pList -> seed << 13;
+    pList -> seed ^= pList -> seed >> 17;
+    pList -> seed ^= pList -> seed << 5;
+
+    unsigned int bits = pList -> seed;
+    while((bits & 3) == 0 && level < LIST_MAX_LEVEL){
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+// internal function
+// 새 노드를 _search 가 기록한 선행 노드(pList -> update) 뒤의 각 층에 연결
+// for _insert function
+// return	1 if successful
+// 			0 if memory overflow
+static int _link_skip( LIST *pList, NODE *newnode){
+    newnode -> level = _random_level(pList);
+    newnode -> skip = NULL;
+    if(newnode -> level == 1) return 1;
+
+    newnode -> skip = malloc(sizeof(NODE *) * (newnode -> level - 1));
+    if(newnode -> skip == NULL) return 0;
+
+    for(int i = 0; i < newnode -> level - 1; i++){
+        NODE *prev = pList -> update[i];
+
+        newnode -> skip[i] = SKIP_NEXT(pList, prev, i);
+        if(prev == NULL) pList -> skipHead[i] = newnode;
+        else prev -> skip[i] = newnode;
+    }
+    if(newnode -> level > pList -> level){
+        pList -> level = newnode -> level;
+    }
+    return 1;
+}
+
+// internal function
+// 삭제할 노드를 각 층에서 떼어냄
+// for _delete function
+static void _unlink_skip( LIST *pList, NODE *pLoc){
+    for(int i = 0; i < pLoc -> level - 1; i++){
+        NODE *prev = pList -> update[i];
+
+        if(prev == NULL) pList -> skipHead[i] = pLoc -> skip[i];
+        else prev -> skip[i] = pLoc -> skip[i];
+    }
+    free(pLoc -> skip);
+
+    while(pList -> level > 1 && pList -> skipHead[pList -> level - 2] == NULL){
+        pList -> level--;
+    }
+}
+
 // internal insert function
 // inserts data into list
 // for addNode function
 // return	1 if successful
 // 			0 if memory overflow
 static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
-    NODE *newnode = malloc(sizeof(NODE));
+    NODE *newnode = pList -> pool != NULL ? POOL_Alloc(pList -> pool) : malloc(sizeof(NODE));
     if(newnode == NULL) return 0;
 
    newnode -> dataPtr = dataInPtr;
+   newnode -> prefix = pList -> prefix != NULL ? pList -> prefix(dataInPtr) : 0;
+   newnode -> level = 1;
+   newnode -> skip = NULL;
+
+   if(pList -> level > 0 && !_link_skip(pList, newnode)){
+        if(pList -> pool != NULL) POOL_Free(pList -> pool, newnode);
+        else free(newnode);
+        return 0;
+   }
 
    if(pPre == NULL){
         newnode -> llink = NULL;
@@ -20,6 +105,9 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
     if(pList -> head != NULL){
         pList -> head -> llink = newnode;
     }
+    else{
+        pList -> rear = newnode;
+    }
     pList -> head = newnode;
    }
 
@@ -38,6 +126,7 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
    }
 
    pList -> count++;
+   pList -> finger = newnode;
 
    return 1;
 
@@ -49,11 +138,19 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
 static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
     *dataOutPtr = pLoc -> dataPtr;
 
+    if(pLoc -> level > 1){
+        _unlink_skip(pList, pLoc);
+    }
+    pList -> finger = pLoc -> rlink != NULL ? pLoc -> rlink : pPre;
+
     if(pPre == NULL){
         pList -> head = pLoc -> rlink;
         if(pList -> head != NULL){
             pList -> head -> llink = NULL;
         }
+        else{
+            pList -> rear = NULL;
+        }
     }
     else{
         pPre -> rlink = pLoc -> rlink;
@@ -65,24 +162,105 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
             pList -> rear = pPre;
         }
     }
-    free(pLoc);
+
+    if(pList -> pool != NULL){
+        POOL_Free(pList -> pool, pLoc);
+    }
+    else{
+        free(pLoc);
+    }
 
     pList -> count--;
 }
 
+// internal search function
+// LIST_FINGER: 마지막으로 찾거나 넣은 노드(finger)에서 키 쪽으로 걸어감 (O(거리))
+// 키가 rear 보다 뒤이거나 head 보다 앞이면 걸어가지 않고 끝에서 바로 결정
+// 찾은 노드 (없으면 키와 가장 가까운 노드) 가 새 finger
+// for _search function
+// return	1 found
+// 			0 not found
+static int _searchFinger( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu, uint64_t keyPrefix){
+    NODE *cur = pList -> finger;
+    int c = _compare(pList, pArgu, keyPrefix, cur);
+
+    if(c > 0 && cur != pList -> rear){
+        if((c = _compare(pList, pArgu, keyPrefix, pList -> rear)) >= 0){
+            cur = pList -> rear;
+        }
+        else{
+            // finger < key < rear 이므로 rear 전에 멈춤
+            do{
+                cur = cur -> rlink;
+            } while((c = _compare(pList, pArgu, keyPrefix, cur)) > 0);
+        }
+    }
+    else if(c < 0 && cur != pList -> head){
+        if((c = _compare(pList, pArgu, keyPrefix, pList -> head)) <= 0){
+            cur = pList -> head;
+        }
+        else{
+            // head < key < finger 이므로 head 전에 멈춤
+            do{
+                cur = cur -> llink;
+            } while((c = _compare(pList, pArgu, keyPrefix, cur)) < 0);
+        }
+    }
+    pList -> finger = cur;
+
+    // c == 0 : cur 이 키, c > 0 : 키가 cur 바로 뒤, c < 0 : 키가 cur 바로 앞
+    if(c > 0){
+        *pPre = cur;
+        *pLoc = cur -> rlink;
+    }
+    else{
+        *pPre = cur -> llink;
+        *pLoc = cur;
+    }
+    return c == 0;
+}
+
 // internal search function
 // searches list and passes back address of node containing target and its logical predecessor
+// skip list 이면 위층부터 내려오며 각 층의 선행 노드를 pList -> update 에 기록하고,
+// 맨 아래층(rlink)은 마지막 선행 노드 다음부터 검색
+// LIST_FINGER 이면 _searchFinger
 // for addNode, removeNode, searchNode functions
 // return	1 found
 // 			0 not found
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu){
     NODE *cur = pList -> head;
     NODE *prev = NULL;
+    uint64_t keyPrefix = pList -> prefix != NULL ? pList -> prefix(pArgu) : 0;
 
+    if(pList -> useFinger && pList -> finger != NULL){
+        return _searchFinger(pList, pPre, pLoc, pArgu, keyPrefix);
+    }
+
+    if(pList -> level > 1){
+        for(int i = LIST_MAX_LEVEL - 2; i >= pList -> level - 1; i--){
+            pList -> update[i] = NULL;
+        }
+        for(int i = pList -> level - 2; i >= 0; i--){
+            NODE *next = SKIP_NEXT(pList, prev, i);
+
+            while(next != NULL && _compare(pList, pArgu, keyPrefix, next) > 0){
+                prev = next;
+                next = next -> skip[i];
+            }
+            pList -> update[i] = prev;
+        }
+        cur = prev != NULL ? prev -> rlink : pList -> head;
+    }
+    else if(pList -> level == 1){
+        for(int i = 0; i < LIST_MAX_LEVEL - 1; i++){
+            pList -> update[i] = NULL;
+        }
+    }
 
 
     while(cur != NULL){
-       int find = pList -> compare(pArgu, cur -> dataPtr);
+       int find = _compare(pList, pArgu, keyPrefix, cur);
 
        if(find == 0){
         *pLoc = cur;
@@ -105,6 +283,69 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu){
     
 }
 
+// internal function
+// batch 를 compare 순서로 정렬 (bottom-up merge sort, 같은 키는 원래 순서 유지)
+// for addNodes function
+//	tmp	data n 개를 담을 작업 배열
+static void _sortBatch( LIST *pList, void **batch, void **tmp, int n){
+    void **src = batch;
+    void **dst = tmp;
+
+    for(int width = 1; width < n; width *= 2){
+        for(int lo = 0; lo < n; lo += 2 * width){
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int i = lo, j = mid, k = lo;
+
+            while(i < mid && j < hi){
+                dst[k++] = pList -> compare(src[j], src[i]) < 0 ? src[j++] : src[i++];
+            }
+            while(i < mid) dst[k++] = src[i++];
+            while(j < hi) dst[k++] = src[j++];
+        }
+
+        void **temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if(src != batch){
+        for(int i = 0; i < n; i++){
+            batch[i] = src[i];
+        }
+    }
+}
+
+// internal heap functions
+// heap[0..n-1] 은 order 기준 max-heap (루트가 지금까지 고른 데이터 중 order 순서로 가장 뒤)
+// for topList function
+static void _heapUp( void **heap, int i, int (*order)(const void *, const void *)){
+    void *item = heap[i];
+
+    while(i > 0){
+        int parent = (i - 1) / 2;
+
+        if(order(heap[parent], item) >= 0) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = item;
+}
+
+static void _heapDown( void **heap, int n, int i, int (*order)(const void *, const void *)){
+    void *item = heap[i];
+
+    while(2 * i + 1 < n){
+        int child = 2 * i + 1;
+
+        if(child + 1 < n && order(heap[child + 1], heap[child]) > 0) child++;
+        if(order(item, heap[child]) >= 0) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = item;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // function declarations
 
@@ -112,6 +353,14 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu){
 // return	head node pointer
 // 			NULL if overflow
 LIST *createList( int (*compare)(const void *, const void *)){
+    return createListEx(compare, 0);
+}
+
+// createList with flags
+//	flags	0 or LIST_POOL | LIST_SKIP | LIST_FINGER
+// return	head node pointer
+// 			NULL if overflow
+LIST *createListEx( int (*compare)(const void *, const void *), int flags){
     LIST *list = malloc(sizeof(LIST));
     if(list == NULL) return NULL;
 
@@ -120,23 +369,70 @@ LIST *createList( int (*compare)(const void *, const void *)){
     list -> rear = NULL;
 
     list -> compare = compare;
+    list -> pool = NULL;
+    list -> level = (flags & LIST_SKIP) ? 1 : 0;
+    list -> seed = 2463534242u;
+    list -> prefix = NULL;
+    list -> useFinger = (flags & LIST_FINGER) && !(flags & LIST_SKIP);
+    list -> finger = NULL;
+
+    for(int i = 0; i < LIST_MAX_LEVEL - 1; i++){
+        list -> skipHead[i] = NULL;
+        list -> update[i] = NULL;
+    }
+
+    if(flags & LIST_POOL){
+        list -> pool = POOL_Create(sizeof(NODE), 0);
+        if(list -> pool == NULL){
+            free(list);
+            return NULL;
+        }
+    }
 
     return list;
 
 }
 
+// Sets a key prefix function (NULL to disable), 이미 있는 노드의 prefix 도 다시 계산
+//	prefix	데이터의 앞 8 바이트를 big-endian 정수로 만든 값 (예: stringPrefix)
+//			prefix(a) < prefix(b) 이면 compare(a, b) < 0 이어야 함
+void setPrefix( LIST *pList, uint64_t (*prefix)(const void *)){
+    pList -> prefix = prefix;
+
+    for(NODE *cur = pList -> head; cur != NULL; cur = cur -> rlink){
+        cur -> prefix = prefix != NULL ? prefix(cur -> dataPtr) : 0;
+    }
+}
+
+// returns first 8 bytes of a C string as a big-endian integer ('\0' 뒤는 0)
+uint64_t stringPrefix( const void *str){
+    const unsigned char *s = str;
+    uint64_t prefix = 0;
+
+    for(int i = 0; i < 8; i++){
+        prefix <<= 8;
+        if(*s != '\0') prefix |= *s++;
+    }
+    return prefix;
+}
+
 //  이름 리스트에 할당된 메모리를 해제 (head node, data node)
 void destroyList( LIST *pList, void (*callback)(void *)){
     NODE *cur = pList -> head;
-    NODE *prev = NULL;
+    NODE *next;
 
     while(cur != NULL){
-        prev = cur;
-        callback(prev -> dataPtr);
-        free(prev);
-        cur = cur -> rlink;
+        next = cur -> rlink;
+        callback(cur -> dataPtr);
+        free(cur -> skip);
+        if(pList -> pool == NULL) free(cur);
+        cur = next;
     }
 
+    // 풀을 쓰는 경우 노드는 슬랩 단위로 한 번에 해제
+    if(pList -> pool != NULL){
+        POOL_Destroy(pList -> pool);
+    }
     free(pList);
 }
 
@@ -156,8 +452,8 @@ int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *)){
         return 2;
     }
 
-    if(_search(pList, &pPre, &pLoc, dataInPtr) == 0){
-        _insert(pList, pPre, dataInPtr);
+    // _search 가 넘겨준 pPre 뒤에 바로 삽입 (다시 검색하지 않음)
+    if(_insert(pList, pPre, dataInPtr) == 1){
         return 1;
     }
 
@@ -166,6 +462,57 @@ int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *)){
     }
 }
 
+// Inserts a batch of data into list
+// batch 를 정렬한 뒤 리스트와 한 번에 병합 (O(count + n log n))
+// 키가 정렬되어 있으므로 지난번 위치부터 계속 검색하고, 새 노드도 그 자리에서 다시 비교해 batch 안의 중복을 찾음
+// skip list 는 정렬하지 않고 키마다 _search (이미 O(log n) 이고, update 를 채워야 _insert 가 각 층에 연결할 수 있음)
+//	batch	data n 개 (skip list 가 아니면 정렬되어 순서가 바뀜), 리스트에 들어간 data 는 NULL 로 바뀜
+//	return	0 if overflow (일부만 들어갔을 수 있음)
+//			1 if successful
+int addNodes( LIST *pList, void **batch, int n, void (*callback)(const void *)){
+    if(pList -> level == 0){
+        void **tmp = malloc(sizeof(void *) * (n > 0 ? n : 1));
+        if(tmp == NULL) return 0;
+
+        _sortBatch(pList, batch, tmp, n);
+        free(tmp);
+    }
+
+    NODE *pPre = NULL;
+    NODE *pLoc = pList -> head;
+
+    for(int i = 0; i < n; i++){
+        void *dataInPtr = batch[i];
+        int found;
+
+        if(pList -> level > 0){
+            found = _search(pList, &pPre, &pLoc, dataInPtr);
+        }
+        else{
+            uint64_t keyPrefix = pList -> prefix != NULL ? pList -> prefix(dataInPtr) : 0;
+            int cmp = 1;
+
+            while(pLoc != NULL && (cmp = _compare(pList, dataInPtr, keyPrefix, pLoc)) > 0){
+                pPre = pLoc;
+                pLoc = pLoc -> rlink;
+            }
+            found = pLoc != NULL && cmp == 0;
+        }
+
+        if(found){
+            callback(pLoc -> dataPtr);
+            continue;
+        }
+
+        if(_insert(pList, pPre, dataInPtr) == 0) return 0;
+        batch[i] = NULL;
+
+        // 다음 키는 새 노드부터 비교 (같은 키면 중복)
+        pLoc = pPre != NULL ? pPre -> rlink : pList -> head;
+    }
+    return 1;
+}
+
 // Removes data from list
 //	return	0 not found
 //			1 deleted
@@ -241,3 +588,32 @@ void traverseListR( LIST *pList, void (*callback)(const void *)){
         cur = cur -> llink;
     }
 }
+
+// 리스트를 한 번 훑으며 order 순서로 앞선 k 개를 골라 dataOutPtr 에 order 순서로 저장
+// 크기 k 의 힙만 유지 (O(n log k), dataOutPtr 외의 추가 메모리 없음)
+//	order	리스트의 compare 와 다른 순서 (예: compare_by_freq)
+//	dataOutPtr	data k 개를 저장할 배열
+//	return	저장한 data 수 (리스트가 k 개보다 적으면 countList)
+int topList( LIST *pList, int k, int (*order)(const void *, const void *), void **dataOutPtr){
+    int n = 0;
+
+    for(NODE *cur = pList -> head; cur != NULL; cur = cur -> rlink){
+        if(n < k){
+            dataOutPtr[n] = cur -> dataPtr;
+            _heapUp(dataOutPtr, n++, order);
+        }
+        else if(n > 0 && order(cur -> dataPtr, dataOutPtr[0]) < 0){
+            dataOutPtr[0] = cur -> dataPtr;
+            _heapDown(dataOutPtr, n, 0, order);
+        }
+    }
+
+    // 힙 정렬: 루트(가장 뒤)를 끝으로 보내며 앞쪽만 다시 힙으로
+    for(int i = n - 1; i > 0; i--){
+        void *temp = dataOutPtr[0];
+        dataOutPtr[0] = dataOutPtr[i];
+        dataOutPtr[i] = temp;
+        _heapDown(dataOutPtr, i, 0, order);
+    }
+    return n;
+}
@@ -1,4 +1,8 @@
 
+#include <stdint.h> // uint64_t
+
+#include "../common/node_pool.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
 typedef struct node
@@ -6,16 +10,35 @@ typedef struct node
 	void		*dataPtr;
 	struct node	*llink;
 	struct node	*rlink;
+	int			level;	// skip list 높이 (1 이면 llink/rlink 만 사용)
+	struct node	**skip;	// skip[i] : 높이 i + 2 에서의 다음 노드 (level 1 이면 NULL)
+	uint64_t	prefix;	// 데이터의 key prefix (setPrefix), 다르면 compare 를 호출하지 않고 결정
 } NODE;
 
+// skip list 최대 높이 (p = 1/4 이므로 4^16 개 노드까지 충분)
+#define LIST_MAX_LEVEL	16
+
 typedef struct
 {
 	int		count;
 	NODE	*head;
 	NODE	*rear;
 	int		(*compare)(const void *, const void *); // used in _search function
+	POOL	*pool;	// node pool (NULL if nodes are allocated by malloc)
+	int		level;	// 0 if not a skip list, else 현재 가장 높은 노드의 높이
+	NODE	*skipHead[LIST_MAX_LEVEL - 1];	// skipHead[i] : 높이 i + 2 의 첫번째 노드
+	NODE	*update[LIST_MAX_LEVEL - 1];	// _search 가 기록한 높이별 선행 노드 (NULL 이면 head)
+	unsigned int	seed;	// 노드 높이를 정하는 난수 상태
+	uint64_t	(*prefix)(const void *);	// key prefix function (NULL if not used)
+	int		useFinger;	// 1 if LIST_FINGER
+	NODE	*finger;	// 마지막으로 찾거나 넣은 노드 (LIST_FINGER 검색의 시작점, NULL if empty)
 } LIST;
 
+// flags (createListEx)
+#define LIST_POOL	0x10	// 노드를 슬랩 메모리 풀에서 할당, destroyList 에서 한 번에 해제
+#define LIST_SKIP	0x20	// llink/rlink 위에 skip list 색인을 두어 검색/삽입/삭제를 O(log n) 으로
+#define LIST_FINGER	0x40	// head 대신 마지막으로 찾거나 넣은 노드부터 앞뒤로 검색 (LIST_SKIP 이면 무시)
+
 ////////////////////////////////////////////////////////////////////////////////
 // function declarations
 
@@ -24,6 +47,20 @@ typedef struct
 // 			NULL if overflow
 LIST *createList( int (*compare)(const void *, const void *));
 
+// createList with flags
+//	flags	0 or LIST_POOL | LIST_SKIP | LIST_FINGER
+// return	head node pointer
+// 			NULL if overflow
+LIST *createListEx( int (*compare)(const void *, const void *), int flags);
+
+// Sets a key prefix function (NULL to disable), 이미 있는 노드의 prefix 도 다시 계산
+//	prefix	데이터의 앞 8 바이트를 big-endian 정수로 만든 값 (예: stringPrefix)
+//			prefix(a) < prefix(b) 이면 compare(a, b) < 0 이어야 함
+void setPrefix( LIST *pList, uint64_t (*prefix)(const void *));
+
+// returns first 8 bytes of a C string as a big-endian integer ('\0' 뒤는 0)
+uint64_t stringPrefix( const void *str);
+
 //  이름 리스트에 할당된 메모리를 해제 (head node, data node)
 void destroyList( LIST *pList, void (*callback)(void *));
 
@@ -34,6 +71,15 @@ void destroyList( LIST *pList, void (*callback)(void *));
 //			2 if duplicated key
 int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *));
 
+// Inserts a batch of data into list
+// batch 를 정렬한 뒤 리스트와 한 번에 병합 (키마다 head 부터 검색하지 않음, LIST_SKIP 이면 키마다 검색)
+// 리스트나 batch 의 앞쪽에 같은 키가 있는 data 는 넣지 않고, 저장된 data 로 callback 호출
+//	batch	data n 개 (LIST_SKIP 이 아니면 정렬되어 순서가 바뀜), 리스트에 들어간 data 는 NULL 로 바뀜
+//			NULL 이 아닌 data 는 중복이므로 호출자가 해제
+//	return	0 if overflow (일부만 들어갔을 수 있음)
+//			1 if successful
+int addNodes( LIST *pList, void **batch, int n, void (*callback)(const void *));
+
 // Removes data from list
 //	return	0 not found
 //			1 deleted
@@ -58,3 +104,9 @@ void traverseList( LIST *pList, void (*callback)(const void *));
 
 // traverses data from list (backward)
 void traverseListR( LIST *pList, void (*callback)(const void *));
+
+// 리스트를 한 번 훑으며 order 순서로 앞선 k 개를 골라 dataOutPtr 에 order 순서로 저장 (O(n log k))
+//	order	리스트의 compare 와 다른 순서 (예: compare_by_freq)
+//	dataOutPtr	data k 개를 저장할 배열
+//	return	저장한 data 수 (리스트가 k 개보다 적으면 countList)
+int topList( LIST *pList, int k, int (*order)(const void *, const void *), void **dataOutPtr);
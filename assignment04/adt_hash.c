@@ -0,0 +1,281 @@
+#include <stdlib.h> // malloc
+
+#include "adt_hash.h"
+
+#define HASH_INIT_BITS	4	// 처음 슬롯 수 16
+
+// 해시값을 섞어서 상위 bits 비트를 시작 위치로 사용 (fibonacci hashing)
+// for _search, _place functions
+static int _home( HASH *pHash, unsigned int hash){
+    return (int)((hash * 2654435769u) >> (32 - pHash -> bits));
+}
+
+// 슬롯 i 에 있는 데이터가 시작 위치에서 떨어진 거리
+static int _distance( HASH *pHash, int i){
+    return (i - _home(pHash, pHash -> slots[i].hash)) & (pHash -> capacity - 1);
+}
+
+// internal search function
+// Robin Hood 불변식: 탐사 거리가 현재 슬롯 데이터의 거리보다 커지면 키가 없음
+// return	index of slot containing key
+// 			-1 not found
+static int _search( HASH *pHash, void *pArgu, unsigned int hash){
+    int mask = pHash -> capacity - 1;
+    int i = _home(pHash, hash);
+    int dist = 0;
+
+    while(pHash -> slots[i].dataPtr != NULL && dist <= _distance(pHash, i)){
+        if(pHash -> slots[i].hash == hash && pHash -> compare(pArgu, pHash -> slots[i].dataPtr) == 0){
+            return i;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+    return -1;
+}
+
+// internal insert function
+// 키가 테이블에 없다고 가정하고 배치
+// 탐사 중 자기보다 시작 위치에 가까운(거리가 짧은) 데이터를 만나면 자리를 바꿔 계속 진행
+static void _place( HASH *pHash, void *dataInPtr, unsigned int hash){
+    int mask = pHash -> capacity - 1;
+    int i = _home(pHash, hash);
+    int dist = 0;
+    SLOT cur = { dataInPtr, hash };
+
+    while(pHash -> slots[i].dataPtr != NULL){
+        int d = _distance(pHash, i);
+
+        if(d < dist){
+            SLOT temp = pHash -> slots[i];
+            pHash -> slots[i] = cur;
+            cur = temp;
+            dist = d;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+    pHash -> slots[i] = cur;
+}
+
+// internal resize function
+// 슬롯 배열을 2^bits 크기로 다시 만들고 모든 데이터를 다시 배치
+// return	1 if successful
+// 			0 if memory overflow
+static int _resize( HASH *pHash, int bits){
+    SLOT *old = pHash -> slots;
+    int oldCapacity = pHash -> capacity;
+
+    SLOT *slots = calloc((size_t)1 << bits, sizeof(SLOT));
+    if(slots == NULL) return 0;
+
+    pHash -> slots = slots;
+    pHash -> bits = bits;
+    pHash -> capacity = 1 << bits;
+
+    for(int i = 0; i < oldCapacity; i++){
+        if(old[i].dataPtr != NULL){
+            _place(pHash, old[i].dataPtr, old[i].hash);
+        }
+    }
+    free(old);
+    return 1;
+}
+
+// 정렬된 배열 from[lo, mid), from[mid, hi) 를 to 에 병합
+static void _merge( void **from, void **to, int lo, int mid, int hi, int (*compare)(const void *, const void *)){
+    int i = lo, j = mid, k = lo;
+
+    while(i < mid && j < hi){
+        if(compare(from[j], from[i]) < 0) to[k++] = from[j++];
+        else to[k++] = from[i++];
+    }
+    while(i < mid) to[k++] = from[i++];
+    while(j < hi) to[k++] = from[j++];
+}
+
+// internal sort function
+// 모든 데이터를 compare 순으로 정렬해 pHash -> sorted 에 저장 (bottom-up merge sort)
+// for traverseHash, traverseHashR functions
+// return	1 if successful
+// 			0 if memory overflow
+static int _sort( HASH *pHash){
+    int n = pHash -> count;
+    void **a = malloc(sizeof(void *) * (n > 0 ? n : 1));
+    void **b = malloc(sizeof(void *) * (n > 0 ? n : 1));
+
+    if(a == NULL || b == NULL){
+        free(a);
+        free(b);
+        return 0;
+    }
+
+    int k = 0;
+    for(int i = 0; i < pHash -> capacity; i++){
+        if(pHash -> slots[i].dataPtr != NULL){
+            a[k++] = pHash -> slots[i].dataPtr;
+        }
+    }
+
+    for(int width = 1; width < n; width *= 2){
+        for(int lo = 0; lo < n; lo += 2 * width){
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            _merge(a, b, lo, mid, hi, pHash -> compare);
+        }
+        void **temp = a;
+        a = b;
+        b = temp;
+    }
+    free(b);
+
+    free(pHash -> sorted);
+    pHash -> sorted = a;
+    pHash -> sortedValid = 1;
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+// Allocates dynamic memory for a hash table and returns its address to caller
+//	compare	같은 키이면 0 (traverse 순서도 이 함수로 정함)
+//	hash	같은 키에 대해 같은 값을 돌려주는 해시 함수
+// return	head pointer
+// 			NULL if overflow
+HASH *createHash( int (*compare)(const void *, const void *), unsigned int (*hash)(const void *)){
+    HASH *table = malloc(sizeof(HASH));
+    if(table == NULL) return NULL;
+
+    table -> slots = calloc((size_t)1 << HASH_INIT_BITS, sizeof(SLOT));
+    if(table -> slots == NULL){
+        free(table);
+        return NULL;
+    }
+
+    table -> count = 0;
+    table -> bits = HASH_INIT_BITS;
+    table -> capacity = 1 << HASH_INIT_BITS;
+    table -> compare = compare;
+    table -> hash = hash;
+    table -> sorted = NULL;
+    table -> sortedValid = 0;
+
+    return table;
+}
+
+// 해시 테이블에 할당된 메모리를 해제 (head, slots, data)
+void destroyHash( HASH *pHash, void (*callback)(void *)){
+    for(int i = 0; i < pHash -> capacity; i++){
+        if(pHash -> slots[i].dataPtr != NULL){
+            callback(pHash -> slots[i].dataPtr);
+        }
+    }
+    free(pHash -> slots);
+    free(pHash -> sorted);
+    free(pHash);
+}
+
+// Inserts data into hash table
+// callback은 이미 테이블에 존재하는 데이터를 발견했을 때 호출하는 함수
+//	return	0 if overflow
+//			1 if successful
+//			2 if duplicated key
+int addHash( HASH *pHash, void *dataInPtr, void (*callback)(const void *)){
+    unsigned int hash = pHash -> hash(dataInPtr);
+
+    int i = _search(pHash, dataInPtr, hash);
+    if(i >= 0){
+        callback(pHash -> slots[i].dataPtr);
+        return 2;
+    }
+
+    // load factor 7/8 을 넘으면 두 배로 늘림
+    if((pHash -> count + 1) * 8 > pHash -> capacity * 7){
+        if(!_resize(pHash, pHash -> bits + 1)) return 0;
+    }
+
+    _place(pHash, dataInPtr, hash);
+    pHash -> count++;
+    pHash -> sortedValid = 0;
+
+    return 1;
+}
+
+// Removes data from hash table
+// 뒤따르는 데이터를 한 칸씩 당겨서 빈 슬롯을 메움 (backward shift, tombstone 없음)
+//	return	0 not found
+//			1 deleted
+int removeHash( HASH *pHash, void *keyPtr, void **dataOutPtr){
+    int mask = pHash -> capacity - 1;
+
+    int i = _search(pHash, keyPtr, pHash -> hash(keyPtr));
+    if(i < 0) return 0;
+
+    *dataOutPtr = pHash -> slots[i].dataPtr;
+
+    int next = (i + 1) & mask;
+    while(pHash -> slots[next].dataPtr != NULL && _distance(pHash, next) > 0){
+        pHash -> slots[i] = pHash -> slots[next];
+        i = next;
+        next = (next + 1) & mask;
+    }
+    pHash -> slots[i].dataPtr = NULL;
+
+    pHash -> count--;
+    pHash -> sortedValid = 0;
+
+    return 1;
+}
+
+// interface to search function
+//	pArgu	key being sought
+//	dataOutPtr	contains found data
+//	return	1 successful
+//			0 not found
+int searchHash( HASH *pHash, void *pArgu, void **dataOutPtr){
+    int i = _search(pHash, pArgu, pHash -> hash(pArgu));
+
+    if(i >= 0){
+        *dataOutPtr = pHash -> slots[i].dataPtr;
+        return 1;
+    }
+    else{
+        return 0;
+    }
+}
+
+// returns number of data in hash table
+int countHash( HASH *pHash){
+    return pHash -> count;
+}
+
+// returns	1 empty
+//			0 hash table has data
+int emptyHash( HASH *pHash){
+    if(pHash -> count == 0){
+        return 1;
+    }
+    else{
+        return 0;
+    }
+}
+
+// traverses data in compare order (forward)
+// 마지막 정렬 이후 삽입/삭제가 있었을 때만 다시 정렬
+void traverseHash( HASH *pHash, void (*callback)(const void *)){
+    if(!pHash -> sortedValid && !_sort(pHash)) return;
+
+    for(int i = 0; i < pHash -> count; i++){
+        callback(pHash -> sorted[i]);
+    }
+}
+
+// traverses data in compare order (backward)
+void traverseHashR( HASH *pHash, void (*callback)(const void *)){
+    if(!pHash -> sortedValid && !_sort(pHash)) return;
+
+    for(int i = pHash -> count - 1; i >= 0; i--){
+        callback(pHash -> sorted[i]);
+    }
+}
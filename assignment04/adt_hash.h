@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// HASH type definition
+// open addressing (Robin Hood) 해시 테이블
+// adt_dlist.h 의 LIST 와 같은 규약(반환값, callback)을 따르며, 순서가 필요한
+// traverseHash / traverseHashR 호출 시에만 정렬된 배열을 만듦
+typedef struct
+{
+	void			*dataPtr;	// NULL if empty
+	unsigned int	hash;		// hash of dataPtr (재해싱, 비교 전 거르기 용)
+} SLOT;
+
+typedef struct
+{
+	int		count;
+	int		capacity;	// 슬롯 수 (2의 거듭제곱)
+	int		bits;		// log2(capacity)
+	SLOT	*slots;
+	int		(*compare)(const void *, const void *);
+	unsigned int	(*hash)(const void *);
+	void	**sorted;		// 정렬된 dataPtr 배열 (traverse 때 필요하면 다시 만듦)
+	int		sortedValid;	// 1 if sorted is up to date
+} HASH;
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+// Allocates dynamic memory for a hash table and returns its address to caller
+//	compare	같은 키이면 0 (traverse 순서도 이 함수로 정함)
+//	hash	같은 키에 대해 같은 값을 돌려주는 해시 함수
+// return	head pointer
+// 			NULL if overflow
+HASH *createHash( int (*compare)(const void *, const void *), unsigned int (*hash)(const void *));
+
+// 해시 테이블에 할당된 메모리를 해제 (head, slots, data)
+void destroyHash( HASH *pHash, void (*callback)(void *));
+
+// Inserts data into hash table
+// callback은 이미 테이블에 존재하는 데이터를 발견했을 때 호출하는 함수
+//	return	0 if overflow
+//			1 if successful
+//			2 if duplicated key
+int addHash( HASH *pHash, void *dataInPtr, void (*callback)(const void *));
+
+// Removes data from hash table
+//	return	0 not found
+//			1 deleted
+int removeHash( HASH *pHash, void *keyPtr, void **dataOutPtr);
+
+// interface to search function
+//	pArgu	key being sought
+//	dataOutPtr	contains found data
+//	return	1 successful
+//			0 not found
+int searchHash( HASH *pHash, void *pArgu, void **dataOutPtr);
+
+// returns number of data in hash table
+int countHash( HASH *pHash);
+
+// returns	1 empty
+//			0 hash table has data
+int emptyHash( HASH *pHash);
+
+// traverses data in compare order (forward)
+void traverseHash( HASH *pHash, void (*callback)(const void *));
+
+// traverses data in compare order (backward)
+void traverseHashR( HASH *pHash, void (*callback)(const void *));
@@ -0,0 +1,593 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc
+#include <string.h> // strcmp, strdup
+#include <stdint.h> // intptr_t
+#include <time.h>   // clock_gettime
+
+#include "adt_dlist.h"
+#include "adt_hash.h"
+#include "../common/word.h"
+#include "dlist_gen.h"
+
+// adt_dlist 벤치마크
+// usage: dlist_bench [FILE]
+//	FILE	단어 파일 (default words.txt)
+// usage: dlist_bench -k [MAX]
+//	서로 다른 합성 단어 10k / 100k / 1M 개로 일반 리스트와 LIST_SKIP 비교
+//	MAX	일반 리스트를 돌릴 최대 개수 (default 10000, O(n^2) 이라 100k 는 수 분 걸림)
+// usage: dlist_bench -g [N]
+//	무작위 정수 키 N개 (default 10000) 로 일반 리스트 (compare 함수 포인터) 와 DEFINE_DLIST 비교
+// usage: dlist_bench -b [FILE]
+//	단어 파일로 tWord 사전을 만들 때 addNode (토큰마다) 와 addNodes (batch 1 ~ 64k) 의 비교 횟수, 시간 비교
+// usage: dlist_bench -f [FILE]
+//	단어 파일 순서 / 1000 토큰씩 정렬한 순서 / 무작위 순서로 tWord 사전을 만들 때 head 검색과 LIST_FINGER 비교
+
+////////////////////////////////////////////////////////////////////////////////
+static int compare_str( const void *p1, const void *p2)
+{
+	return strcmp( (const char *)p1, (const char *)p2);
+}
+
+static int compare_int( const void *p1, const void *p2)
+{
+	intptr_t k1 = (intptr_t)p1;
+	intptr_t k2 = (intptr_t)p2;
+
+	return (k1 > k2) - (k1 < k2);
+}
+
+// FNV-1a
+static unsigned int hash_str( const void *p)
+{
+	const unsigned char *s = p;
+	unsigned int h = 2166136261u;
+
+	while (*s)
+	{
+		h ^= *s++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void no_free( void *p)
+{
+	(void)p;
+}
+
+static void no_dup( const void *p)
+{
+	(void)p;
+}
+
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// 문자열을 따로 할당해 가리키는 이전 형식의 단어 구조체 (word_run 에서 tWord 와 비교)
+typedef struct
+{
+	char	*word;
+	int		freq;
+} tHeapWord;
+
+static int compare_heap( const void *p1, const void *p2)
+{
+	return strcmp( ((const tHeapWord *)p1)->word, ((const tHeapWord *)p2)->word);
+}
+
+static void destroy_heap( void *p)
+{
+	free( ((tHeapWord *)p)->word);
+	free( p);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 단어 파일 전체를 addNode 로 입력
+static void ingest_run( int flags, char **words, int n)
+{
+	LIST *list = createListEx( compare_str, flags);
+	double t0, t1, t2;
+	int i, count;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		addNode( list, words[i], no_dup);
+	t1 = now_ms();
+	count = countList( list);
+	destroyList( list, no_free);
+	t2 = now_ms();
+
+	printf( "%-12s %-6s %9d %9d  ingest %8.1f ms  destroy %6.2f ms\n", "words",
+		flags & LIST_SKIP ? "skip" : flags & LIST_POOL ? "pool" : "malloc", n, count, t1 - t0, t2 - t1);
+}
+
+// 단어 구조체로 사전 만들기 (없으면 추가, 있으면 빈도 증가) 후 모든 토큰을 다시 검색
+// inline 이 0 이면 tHeapWord (단어 문자열을 strdup), 1 이면 tWord (짧은 단어는 구조체 안에 저장)
+static void word_run( int flags, int inl, char **words, int n)
+{
+	LIST *list = createListEx( inl ? compare_by_word : compare_heap, flags);
+	double t0, t1, t2;
+	tWord key;
+	tHeapWord heapKey;
+	void *key_ = inl ? (void *)&key : (void *)&heapKey;
+	void *out;
+	int i;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+	{
+		if (inl)
+			set_key( &key, words[i]);
+		else
+			heapKey.word = words[i];
+
+		if (searchNode( list, key_, &out))
+		{
+			if (inl)
+				((tWord *)out)->freq++;
+			else
+				((tHeapWord *)out)->freq++;
+		}
+		else if (inl)
+			addNode( list, createWord( words[i]), no_dup);
+		else
+		{
+			tHeapWord *pWord = malloc( sizeof(tHeapWord));
+			pWord->word = strdup( words[i]);
+			pWord->freq = 1;
+			addNode( list, pWord, no_dup);
+		}
+	}
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+	{
+		if (inl)
+			set_key( &key, words[i]);
+		else
+			heapKey.word = words[i];
+		searchNode( list, key_, &out);
+	}
+	t2 = now_ms();
+
+	printf( "%-12s %-6s %-6s %9d %9d  ingest %8.1f ms  search %8.1f ns/op\n", "tWord",
+		flags & LIST_SKIP ? "skip" : "list", inl ? "inline" : "heap", n, countList( list),
+		t1 - t0, (t2 - t1) * 1e6 / n);
+	destroyList( list, inl ? destroyWord : destroy_heap);
+}
+
+// compare_by_word 호출 횟수를 셈 (prefix_run)
+static long compared;
+
+static int count_compare( const void *p1, const void *p2)
+{
+	compared++;
+	return compare_by_word( p1, p2);
+}
+
+// tWord 사전을 만들고 모든 토큰을 다시 검색, setPrefix( word_prefix) 유무 비교
+static void prefix_run( int flags, int prefix, char **words, int n)
+{
+	LIST *list = createListEx( count_compare, flags);
+	double t0, t1, t2;
+	long c0, c1;
+	tWord key;
+	void *out;
+	int i;
+
+	if (prefix)
+		setPrefix( list, word_prefix);
+
+	compared = 0;
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+	{
+		set_key( &key, words[i]);
+		if (searchNode( list, &key, &out))
+			((tWord *)out)->freq++;
+		else
+			addNode( list, createWord( words[i]), no_dup);
+	}
+	t1 = now_ms();
+	c0 = compared;
+	for (i = 0; i < n; i++)
+	{
+		set_key( &key, words[i]);
+		searchNode( list, &key, &out);
+	}
+	t2 = now_ms();
+	c1 = compared - c0;
+
+	printf( "%-12s %-6s %-6s %9d  ingest %8.1f ms %8.1f cmp/op  search %8.1f ns/op %8.1f cmp/op\n", "prefix",
+		flags & LIST_SKIP ? "skip" : "list", prefix ? "on" : "off", n,
+		t1 - t0, (double)c0 / n, (t2 - t1) * 1e6 / n, (double)c1 / n);
+	destroyList( list, destroyWord);
+}
+
+// addNodes 의 중복 callback: 저장된 단어의 빈도 증가
+static void inc_freq( const void *p)
+{
+	((tWord *)p)->freq++;
+}
+
+// tWord 사전 만들기: batch 가 0 이면 토큰마다 addNode, 아니면 batch 개씩 addNodes
+// 중복 단어 구조체는 바로 해제, 끝나고 빈도 합이 토큰 수와 같은지 확인 (비교 횟수는 compare_by_freq 제외)
+static int batch_run( int flags, int batch, char **words, int n)
+{
+	LIST *list = createListEx( count_compare, flags);
+	void **buf = malloc( sizeof(void *) * (batch > 0 ? batch : 1));
+	void **all;
+	double t0, t1;
+	long total = 0;
+	int i, j, k, m = 0;
+
+	compared = 0;
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+	{
+		tWord *pWord = createWord( words[i]);
+
+		if (batch == 0)
+		{
+			if (addNode( list, pWord, inc_freq) == 2)
+				destroyWord( pWord);
+			continue;
+		}
+		buf[m++] = pWord;
+		if (m == batch || i == n - 1)
+		{
+			addNodes( list, buf, m, inc_freq);
+			for (j = 0; j < m; j++)
+				if (buf[j] != NULL)
+					destroyWord( buf[j]);
+			m = 0;
+		}
+	}
+	t1 = now_ms();
+
+	all = malloc( sizeof(void *) * (countList( list) + 1));
+	k = topList( list, countList( list), compare_by_freq, all);
+	for (i = 0; i < k; i++)
+		total += ((tWord *)all[i])->freq;
+	free( all);
+
+	if (batch == 0)
+		printf( "%-12s %-6s %9s %9d %9d  ingest %8.1f ms %8.1f cmp/op\n", "batch",
+			flags & LIST_SKIP ? "skip" : "list", "addNode", n, countList( list), t1 - t0, (double)compared / n);
+	else
+		printf( "%-12s %-6s %9d %9d %9d  ingest %8.1f ms %8.1f cmp/op\n", "batch",
+			flags & LIST_SKIP ? "skip" : "list", batch, n, countList( list), t1 - t0, (double)compared / n);
+
+	destroyList( list, destroyWord);
+	free( buf);
+	if (total != n)
+	{
+		fprintf( stderr, "batch %d : frequencies do not add up\n", batch);
+		return 1;
+	}
+	return 0;
+}
+
+static int batch_bench( char **words, int n)
+{
+	int sizes[] = { 0, 1, 16, 256, 4096, 65536 };
+	int s, bad = 0;
+
+	for (s = 0; s < 6; s++)
+		bad |= batch_run( 0, sizes[s], words, n);
+	for (s = 0; s < 6; s++)
+		bad |= batch_run( LIST_SKIP, sizes[s], words, n);
+	return bad;
+}
+
+// tWord 사전을 만들고 (없으면 추가, 있으면 빈도 증가) 모든 토큰을 다시 검색
+// order 는 입력 순서 이름 (출력용)
+static void finger_run( int flags, const char *order, char **words, int n)
+{
+	LIST *list = createListEx( count_compare, flags);
+	double t0, t1, t2;
+	long c0, c1;
+	tWord key;
+	void *out;
+	int i;
+
+	compared = 0;
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+	{
+		set_key( &key, words[i]);
+		if (searchNode( list, &key, &out))
+			((tWord *)out)->freq++;
+		else
+			addNode( list, createWord( words[i]), no_dup);
+	}
+	t1 = now_ms();
+	c0 = compared;
+	for (i = 0; i < n; i++)
+	{
+		set_key( &key, words[i]);
+		searchNode( list, &key, &out);
+	}
+	t2 = now_ms();
+	c1 = compared - c0;
+
+	printf( "%-12s %-6s %-6s %9d  ingest %8.1f ms %8.1f cmp/op  search %8.1f ns/op %8.1f cmp/op\n", "finger",
+		order, flags & LIST_FINGER ? "finger" : "head", n,
+		t1 - t0, (double)c0 / n, (t2 - t1) * 1e6 / n, (double)c1 / n);
+	destroyList( list, destroyWord);
+}
+
+static int compare_ptr_str( const void *p1, const void *p2)
+{
+	return strcmp( *(char * const *)p1, *(char * const *)p2);
+}
+
+static int finger_bench( char **words, int n)
+{
+	char **chunked = malloc( sizeof(char *) * n);
+	char **shuffled = malloc( sizeof(char *) * n);
+	int i, chunk = 1000;
+
+	// 1000 토큰씩 정렬 (지역성이 강한 입력), 전체를 섞음 (지역성이 없는 입력)
+	memcpy( chunked, words, sizeof(char *) * n);
+	for (i = 0; i < n; i += chunk)
+		qsort( chunked + i, n - i < chunk ? n - i : chunk, sizeof(char *), compare_ptr_str);
+	memcpy( shuffled, words, sizeof(char *) * n);
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = rand() % (i + 1);
+		char *t = shuffled[i];
+		shuffled[i] = shuffled[j];
+		shuffled[j] = t;
+	}
+
+	finger_run( 0, "file", words, n);
+	finger_run( LIST_FINGER, "file", words, n);
+	finger_run( 0, "chunk", chunked, n);
+	finger_run( LIST_FINGER, "chunk", chunked, n);
+	finger_run( 0, "random", shuffled, n);
+	finger_run( LIST_FINGER, "random", shuffled, n);
+
+	free( chunked);
+	free( shuffled);
+	return 0;
+}
+
+// 같은 단어 파일을 addHash 로 입력한 뒤 전부 검색, 정렬 순회
+static long visited;
+
+static void count_visit( const void *p)
+{
+	(void)p;
+	visited++;
+}
+
+static void hash_run( char **words, int n)
+{
+	HASH *table = createHash( compare_str, hash_str);
+	double t0, t1, t2, t3;
+	void *out;
+	int i;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		addHash( table, words[i], no_dup);
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+		searchHash( table, words[i], &out);
+	t2 = now_ms();
+	visited = 0;
+	traverseHash( table, count_visit);
+	t3 = now_ms();
+
+	printf( "%-12s %-6s %9d %9d  ingest %8.1f ms  search %6.1f ms  sorted traverse %6.2f ms\n", "words",
+		"hash", n, countHash( table), t1 - t0, t2 - t1, t3 - t2);
+	destroyHash( table, no_free);
+}
+
+// 내림차순 키 n개를 addNode (항상 head 에 삽입되므로 노드 할당 비용이 대부분)
+// 이후 전부 removeNode, 다시 addNode, destroyList
+static void alloc_run( int flags, int n)
+{
+	LIST *list = createListEx( compare_int, flags);
+	double t0, t1, t2, t3, t4;
+	void *out;
+	intptr_t i;
+
+	t0 = now_ms();
+	for (i = n; i > 0; i--)
+		addNode( list, (void *)i, no_dup);
+	t1 = now_ms();
+	for (i = 1; i <= n; i++)
+		removeNode( list, (void *)i, &out);
+	t2 = now_ms();
+	for (i = n; i > 0; i--)
+		addNode( list, (void *)i, no_dup);
+	t3 = now_ms();
+	destroyList( list, no_free);
+	t4 = now_ms();
+
+	printf( "%-12s %-6s %9d  add %7.1f ms  remove %7.1f ms  re-add %7.1f ms  destroy %6.1f ms\n", "head-insert",
+		flags & LIST_POOL ? "pool" : "malloc", n, t1 - t0, t2 - t1, t3 - t2, t4 - t3);
+}
+
+// 무작위 순서의 서로 다른 단어 n개를 addNode, 전부 searchNode, 양방향 순회, 전부 removeNode
+static void skip_run( int flags, char **words, int n)
+{
+	LIST *list = createListEx( compare_str, flags);
+	double t0, t1, t2, t3, t4;
+	void *out;
+	int i;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		addNode( list, words[i], no_dup);
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+		searchNode( list, words[i], &out);
+	t2 = now_ms();
+	visited = 0;
+	traverseList( list, count_visit);
+	traverseListR( list, count_visit);
+	t3 = now_ms();
+	for (i = 0; i < n; i++)
+		removeNode( list, words[i], &out);
+	t4 = now_ms();
+
+	printf( "%-6s %8d  add %10.1f ms  search %10.1f ms  traverse x2 %6.1f ms  remove %10.1f ms\n",
+		flags & LIST_SKIP ? "skip" : "list", n, t1 - t0, t2 - t1, t3 - t2, t4 - t3);
+	destroyList( list, no_free);
+}
+
+static int skip_bench( int maxList)
+{
+	int sizes[] = { 10000, 100000, 1000000 };
+	int max = 1000000;
+	char **words = malloc( sizeof(char *) * max);
+	char word[16];
+	int i, s;
+
+	for (i = 0; i < max; i++)
+	{
+		sprintf( word, "w%07d", i);
+		words[i] = strdup( word);
+	}
+	srand( 1);
+	for (i = max - 1; i > 0; i--)
+	{
+		int j = rand() % (i + 1);
+		char *t = words[i];
+		words[i] = words[j];
+		words[j] = t;
+	}
+
+	for (s = 0; s < 3; s++)
+	{
+		if (sizes[s] <= maxList)
+			skip_run( 0, words, sizes[s]);
+		skip_run( LIST_SKIP, words, sizes[s]);
+	}
+
+	for (i = 0; i < max; i++)
+		free( words[i]);
+	free( words);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 키 타입과 비교를 고정한 리스트 (gen_bench)
+#define INT_CMP( a, b)	(((a) > (b)) - ((a) < (b)))
+
+DEFINE_DLIST( ilist, intptr_t, INT_CMP)
+
+static int gen_bench( int n)
+{
+	intptr_t *keys = malloc( sizeof(intptr_t) * n);
+	LIST *list = createListEx( compare_int, 0);
+	ilist_LIST *ilist = ilist_create();
+	double t0, t1, t2;
+	void *out;
+	int i, bad = 0;
+
+	for (i = 0; i < n; i++)
+		keys[i] = i + 1;
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = rand() % (i + 1);
+		intptr_t t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		addNode( list, (void *)keys[i], no_dup);
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+		bad |= !searchNode( list, (void *)keys[i], &out);
+	t2 = now_ms();
+	printf( "%-12s %-8s %9d  add %8.1f ms  search %8.1f ms\n", "random-int", "generic", n, t1 - t0, t2 - t1);
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		ilist_add( ilist, keys[i]);
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+		bad |= ilist_search( ilist, keys[i]) == NULL;
+	t2 = now_ms();
+	printf( "%-12s %-8s %9d  add %8.1f ms  search %8.1f ms\n", "random-int", "DEFINE", n, t1 - t0, t2 - t1);
+
+	destroyList( list, no_free);
+	ilist_destroy( ilist);
+	free( keys);
+	if (bad)
+		fprintf( stderr, "search failed\n");
+	return bad;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int batch = argc > 1 && strcmp( argv[1], "-b") == 0;
+	int finger = argc > 1 && strcmp( argv[1], "-f") == 0;
+	const char *path = argc > 1 + batch + finger ? argv[1 + batch + finger] : "words.txt";
+	char **words;
+	char word[100];
+	FILE *fp;
+	int i, nwords = 0, cap = 1024, ret = 0;
+
+	if (argc > 1 && strcmp( argv[1], "-k") == 0)
+		return skip_bench( argc > 2 ? atoi( argv[2]) : 10000);
+	if (argc > 1 && strcmp( argv[1], "-g") == 0)
+		return gen_bench( argc > 2 ? atoi( argv[2]) : 10000);
+
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	words = malloc( sizeof(char *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (nwords == cap)
+			words = realloc( words, sizeof(char *) * (cap *= 2));
+		words[nwords++] = strdup( word);
+	}
+	fclose( fp);
+
+	if (batch)
+		ret = batch_bench( words, nwords);
+	else if (finger)
+		ret = finger_bench( words, nwords);
+	else
+	{
+		ingest_run( 0, words, nwords);
+		ingest_run( LIST_POOL, words, nwords);
+		ingest_run( LIST_SKIP, words, nwords);
+		hash_run( words, nwords);
+
+		word_run( 0, 0, words, nwords);
+		word_run( 0, 1, words, nwords);
+		word_run( LIST_SKIP, 0, words, nwords);
+		word_run( LIST_SKIP, 1, words, nwords);
+
+		prefix_run( 0, 0, words, nwords);
+		prefix_run( 0, 1, words, nwords);
+		prefix_run( LIST_SKIP, 0, words, nwords);
+		prefix_run( LIST_SKIP, 1, words, nwords);
+
+		alloc_run( 0, 1000000);
+		alloc_run( LIST_POOL, 1000000);
+	}
+
+	for (i = 0; i < nwords; i++)
+		free( words[i]);
+	free( words);
+
+	return ret;
+}
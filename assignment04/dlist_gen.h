@@ -0,0 +1,165 @@
+#ifndef DLIST_GEN_H
+#define DLIST_GEN_H
+
+#include <stdlib.h> // malloc
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE_DLIST( name, T, cmp)
+// 키 타입 T 와 비교 cmp 를 컴파일 시점에 고정한 정렬된 이중 연결 리스트를 만듦
+// 노드에 void * 대신 T 를 직접 저장하고 cmp 를 함수 포인터 없이 호출하므로 비교가 인라인됨
+//	T			키 타입 (int, intptr_t, const char * 등, 대입으로 복사)
+//	cmp( a, b)	T 두 개를 받아 a < b 이면 음수, 같으면 0, a > b 이면 양수 (함수 또는 매크로)
+//
+// 만들어지는 타입과 함수 (name 이 접두사, 반환값 규약은 adt_dlist.h 와 같음)
+//	name_NODE, name_LIST
+//	name_create, name_destroy, name_add, name_remove, name_search, name_count,
+//	name_traverse, name_traverseR
+//
+// adt_dlist.h 의 void * / compare 함수 포인터 API (LIST_POOL, LIST_SKIP 포함) 는
+// 그대로 일반(generic) 버전으로 사용
+// 예)	#define INT_CMP( a, b)	(((a) > (b)) - ((a) < (b)))
+//		DEFINE_DLIST( ilist, int, INT_CMP)
+//		ilist_LIST *list = ilist_create();
+
+#define DEFINE_DLIST( name, T, cmp) \
+\
+typedef struct name##_node \
+{ \
+	T					key; \
+	struct name##_node	*llink; \
+	struct name##_node	*rlink; \
+} name##_NODE; \
+\
+typedef struct \
+{ \
+	int			count; \
+	name##_NODE	*head; \
+	name##_NODE	*rear; \
+} name##_LIST; \
+\
+/* internal search function \
+	passes back node containing key (pLoc) and its logical predecessor (pPre) \
+	return	1 found \
+			0 not found \
+*/ \
+static inline int name##__search( name##_LIST *pList, name##_NODE **pPre, name##_NODE **pLoc, T key){ \
+	name##_NODE *prev = NULL; \
+	name##_NODE *cur = pList -> head; \
+	int c = 1; \
+\
+	while(cur != NULL && (c = cmp(key, cur -> key)) > 0){ \
+		prev = cur; \
+		cur = cur -> rlink; \
+	} \
+	*pPre = prev; \
+	*pLoc = cur; \
+	return cur != NULL && c == 0; \
+} \
+\
+/* Allocates dynamic memory for a list head node \
+	return	head node pointer \
+			NULL if overflow \
+*/ \
+static inline name##_LIST *name##_create( void){ \
+	name##_LIST *pList = malloc(sizeof(name##_LIST)); \
+	if(pList == NULL) return NULL; \
+\
+	pList -> count = 0; \
+	pList -> head = NULL; \
+	pList -> rear = NULL; \
+	return pList; \
+} \
+\
+/* 리스트에 할당된 메모리를 해제 (head node, data node) \
+*/ \
+static inline void name##_destroy( name##_LIST *pList){ \
+	name##_NODE *cur = pList -> head; \
+\
+	while(cur != NULL){ \
+		name##_NODE *next = cur -> rlink; \
+		free(cur); \
+		cur = next; \
+	} \
+	free(pList); \
+} \
+\
+/* Inserts key into list \
+	return	0 if overflow \
+			1 if successful \
+			2 if duplicated key \
+*/ \
+static inline int name##_add( name##_LIST *pList, T key){ \
+	name##_NODE *pPre, *pLoc; \
+\
+	if(name##__search(pList, &pPre, &pLoc, key)) return 2; \
+\
+	name##_NODE *newnode = malloc(sizeof(name##_NODE)); \
+	if(newnode == NULL) return 0; \
+\
+	newnode -> key = key; \
+	newnode -> llink = pPre; \
+	newnode -> rlink = pLoc; \
+	if(pPre == NULL) pList -> head = newnode; \
+	else pPre -> rlink = newnode; \
+	if(pLoc == NULL) pList -> rear = newnode; \
+	else pLoc -> llink = newnode; \
+\
+	pList -> count++; \
+	return 1; \
+} \
+\
+/* Removes key from list \
+	keyOut	삭제된 노드의 키 (NULL 이면 저장하지 않음) \
+	return	0 not found \
+			1 deleted \
+*/ \
+static inline int name##_remove( name##_LIST *pList, T key, T *keyOut){ \
+	name##_NODE *pPre, *pLoc; \
+\
+	if(!name##__search(pList, &pPre, &pLoc, key)) return 0; \
+\
+	if(keyOut != NULL) *keyOut = pLoc -> key; \
+	if(pPre == NULL) pList -> head = pLoc -> rlink; \
+	else pPre -> rlink = pLoc -> rlink; \
+	if(pLoc -> rlink == NULL) pList -> rear = pPre; \
+	else pLoc -> rlink -> llink = pPre; \
+	free(pLoc); \
+\
+	pList -> count--; \
+	return 1; \
+} \
+\
+/* interface to search function \
+	return	address of key stored in the node \
+			NULL not found \
+*/ \
+static inline T *name##_search( name##_LIST *pList, T key){ \
+	name##_NODE *pPre, *pLoc; \
+\
+	if(!name##__search(pList, &pPre, &pLoc, key)) return NULL; \
+	return &pLoc -> key; \
+} \
+\
+/* returns number of nodes in list \
+*/ \
+static inline int name##_count( name##_LIST *pList){ \
+	return pList -> count; \
+} \
+\
+/* traverses keys from list (forward) \
+*/ \
+static inline void name##_traverse( name##_LIST *pList, void (*callback)(T)){ \
+	for(name##_NODE *cur = pList -> head; cur != NULL; cur = cur -> rlink){ \
+		callback(cur -> key); \
+	} \
+} \
+\
+/* traverses keys from list (backward) \
+*/ \
+static inline void name##_traverseR( name##_LIST *pList, void (*callback)(T)){ \
+	for(name##_NODE *cur = pList -> rear; cur != NULL; cur = cur -> llink){ \
+		callback(cur -> key); \
+	} \
+}
+
+#endif
@@ -3,30 +3,112 @@
 
 #include "bst.h"
 
+// internal function declarations
+static int _insert( TREE *pTree, NODE *newPtr, void (*callback)(void *));
+static NODE *_insertAVL( TREE *pTree, NODE *newPtr, void (*callback)(void *), int *result);
+static NODE *_makeNode( TREE *pTree, void *dataInPtr);
+static void _freeNode( POOL *pool, NODE *node);
+static void _destroy( NODE *root, void (*callback)(void *), POOL *pool);
+static NODE *_delete( TREE *pTree, void *keyPtr, void **dataOutPtr);
+static NODE *_search( TREE *pTree, void *keyPtr);
+static void _traverse( TREE *pTree, int direction, void (*callback)(const void *));
+static void _inorder_print( NODE *root, int level, void (*callback)(const void *));
+static int _getHeight( NODE *root);
+static NODE *_balance( NODE *root);
+static int _flatten( TREE *pTree, NODE **out);
+static void _eytzinger( NODE **sorted, void **keys, int n);
+static NODE *_link( NODE **nodes, int n);
+static TREE *_build( int (*compare)(const void *, const void *), int mode, int n, void **sorted, void *(*next)(void *), void *ctx);
+static int _iterInit( ITER *pIter, TREE *pTree, int direction);
+static NODE *_iterStep( ITER *pIter);
+static int _iterPush( ITER *pIter, NODE *node);
+static int _iterDescend( ITER *pIter, NODE *cur);
+static int _iterSeek( ITER *pIter, void *keyPtr, int inclusive);
+static int _rank( TREE *pTree, void *keyPtr, int inclusive);
+static void _heapOffer( void **heap, int *n, int k, void *dataPtr, int (*order)(const void *, const void *));
+static void _heapDown( void **heap, int n, int i, int (*order)(const void *, const void *));
+
+// 키의 prefix 가 노드의 prefix 와 다르면 정수 비교만으로 결정하고, 같을 때만 compare 호출
+// prefix 함수가 없는 트리는 모든 prefix 가 0 이므로 항상 compare 를 호출
+static inline int _compare( TREE *pTree, void *keyPtr, uint64_t keyPrefix, NODE *node){
+	if(keyPrefix != node -> prefix){
+		return keyPrefix < node -> prefix ? -1 : 1;
+	}
+	return pTree -> compare(keyPtr, node -> dataPtr);
+}
+
+// AVL 트리 높이 상한 (1.44 log2(n) < 64), _insertAVL/_delete 의 경로 스택 크기
+#define BST_MAX_HEIGHT	64
+
+// _inorder_print, _getHeight 에서 쓰는 명시적 스택의 원소
+typedef struct
+{
+	NODE	*node;
+	int		level;
+} FRAME;
+
+// BST_SearchFrozen 에서 다음 레벨의 캐시 라인을 미리 읽어 둠
+#if defined(__GNUC__)
+#define PREFETCH( addr)	__builtin_prefetch(addr)
+#else
+#define PREFETCH( addr)
+#endif
+
+// 64-byte 캐시 라인 하나에 들어가는 keys 원소 수 (keys[8k..8k+7] 는 keys[k] 의 3 레벨 아래 자손)
+#define FROZEN_LINE	(64 / sizeof(void *))
+
 
 // Prototype declarations
 
 /* Allocates dynamic memory for a tree head node and returns its address to caller
+	same as BST_CreateEx( compare, BST_PLAIN)
 	return	head node pointer
 			NULL if overflow
 */
 TREE *BST_Create( int (*compare)(const void *, const void *)){
+	return BST_CreateEx(compare, BST_PLAIN);
+}
+
+/* Allocates dynamic memory for a tree head node with balancing mode
+	mode	BST_PLAIN or BST_AVL, optionally | BST_POOL
+	return	head node pointer
+			NULL if overflow or unknown mode
+*/
+TREE *BST_CreateEx( int (*compare)(const void *, const void *), int mode){
+	int balance = mode & ~BST_POOL;
+	if(balance != BST_PLAIN && balance != BST_AVL) return NULL;
+
     TREE *newtree = (TREE *)malloc(sizeof(TREE));
     if(newtree == NULL) return NULL;
 
     newtree -> count = 0;
     newtree -> root = NULL;
     newtree -> compare = compare;
+    newtree -> mode = balance;
+    newtree -> pool = NULL;
+    newtree -> prefix = NULL;
+
+    if(mode & BST_POOL){
+        newtree -> pool = POOL_Create(sizeof(NODE), 0);
+        if(newtree -> pool == NULL){
+            free(newtree);
+            return NULL;
+        }
+    }
 
     return newtree;
 }
 
-/* Deletes all data in tree and recycles memory
+/* Deletes all data in tree and recycles memory (head node, data node, node pool)
 */
 void BST_Destroy( TREE *pTree, void (*callback)(void *)){
-	_destroy(pTree -> root, callback);
-	pTree -> root = NULL;
-	pTree -> count = 0;
+	_destroy(pTree -> root, callback, pTree -> pool);
+
+	// 풀을 쓰는 경우 노드는 슬랩 단위로 한 번에 해제
+	if(pTree -> pool != NULL){
+		POOL_Destroy(pTree -> pool);
+	}
+	free(pTree);
 }
 
 /* Inserts new data into the tree
@@ -36,7 +118,7 @@ void BST_Destroy( TREE *pTree, void (*callback)(void *)){
 			2 if duplicated key
 */
 int BST_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *)){
-	NODE *newnode = _makeNode(dataInPtr);
+	NODE *newnode = _makeNode(pTree, dataInPtr);
 	if(newnode == NULL) return 0;
 
 	if(pTree -> root == NULL){
@@ -45,13 +127,20 @@ int BST_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *)){
 		return 1;
 	}
 
-	int result = _insert(pTree -> root, newnode, pTree -> compare, callback);
+	int result;
+	if(pTree -> mode == BST_AVL){
+		pTree -> root = _insertAVL(pTree, newnode, callback, &result);
+	}
+	else{
+		result = _insert(pTree, newnode, callback);
+	}
 
 	if(result == 1){
 		pTree -> count++;
 		return 1;
 	}
 	else{
+		_freeNode(pTree -> pool, newnode);
 		return 2; 
 	}
 	
@@ -63,7 +152,7 @@ int BST_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *)){
 */
 void *BST_Delete( TREE *pTree, void *keyPtr){
 	void *dataOutPtr = NULL;
-	pTree -> root = _delete(pTree -> root, keyPtr, &dataOutPtr, pTree -> compare);
+	pTree -> root = _delete(pTree, keyPtr, &dataOutPtr);
 
 	if(dataOutPtr != NULL){
 		pTree -> count--;
@@ -79,117 +168,550 @@ void *BST_Search( TREE *pTree, void *keyPtr){
 
 	if(pTree -> root == NULL) return NULL;
 
-	NODE *found = _search(pTree -> root, keyPtr, pTree -> compare);
+	NODE *found = _search(pTree, keyPtr);
 
 	if(found == NULL) return NULL;
 	else return found -> dataPtr;
 }
 
 /* prints tree using inorder traversal
+	트리를 고치지 않으므로 callback 안에서 BST_Search 같은 읽기 연산을 해도 됨 (삽입/삭제는 안 됨)
+	여러 스레드가 락으로 보호할 때는 읽기 연산으로 취급 (읽기 락으로 충분)
 */
-void BST_Traverse( TREE *pTree, void (*callback)(const void *));
+void BST_Traverse( TREE *pTree, void (*callback)(const void *)){
+	_traverse(pTree, BST_FORWARD, callback);
+}
 
 /* prints tree using right-to-left inorder traversal
 */
-void BST_TraverseR( TREE *pTree, void (*callback)(const void *));
+void BST_TraverseR( TREE *pTree, void (*callback)(const void *)){
+	_traverse(pTree, BST_BACKWARD, callback);
+}
+
+/* Allocates an iterator positioned at the first data (BST_FORWARD: 최솟값, BST_BACKWARD: 최댓값)
+	return	iterator pointer
+			NULL if overflow or unknown direction
+*/
+ITER *BST_IterCreate( TREE *pTree, int direction){
+	if(direction != BST_FORWARD && direction != BST_BACKWARD) return NULL;
+
+	ITER *pIter = malloc(sizeof(ITER));
+	if(pIter == NULL) return NULL;
+
+	if(!_iterInit(pIter, pTree, direction)){
+		free(pIter);
+		return NULL;
+	}
+	return pIter;
+}
+
+/* Deletes iterator (트리와 data 는 해제하지 않음)
+*/
+void BST_IterDestroy( ITER *pIter){
+	free(pIter -> stack);
+	free(pIter);
+}
+
+/* Moves iterator back to the first data in its direction
+	return	1 success
+			0 overflow
+*/
+int BST_IterFirst( ITER *pIter){
+	pIter -> top = 0;
+	return _iterDescend(pIter, pIter -> tree -> root);
+}
+
+/* Moves iterator to the first data not past keyPtr in O(log n)
+	BST_FORWARD		keyPtr 이상인 첫 data (lower_bound)
+	BST_BACKWARD	keyPtr 이하인 마지막 data
+	return	1 success
+			0 overflow
+*/
+int BST_IterLowerBound( ITER *pIter, void *keyPtr){
+	return _iterSeek(pIter, keyPtr, 1);
+}
+
+/* Moves iterator to the first data strictly past keyPtr in O(log n)
+	BST_FORWARD		keyPtr 보다 큰 첫 data (upper_bound)
+	BST_BACKWARD	keyPtr 보다 작은 마지막 data
+	return	1 success
+			0 overflow
+*/
+int BST_IterUpperBound( ITER *pIter, void *keyPtr){
+	return _iterSeek(pIter, keyPtr, 0);
+}
+
+/* Moves iterator to the k-th data in its direction in O(log n) (0-based, 페이지 단위 출력 등)
+	BST_FORWARD 이면 k번째로 작은 data, BST_BACKWARD 이면 k번째로 큰 data
+	k 가 범위를 벗어나면 더 읽을 data 가 없는 상태가 됨
+	return	1 success
+			0 overflow
+*/
+int BST_IterSelect( ITER *pIter, int k){
+	int forward = pIter -> direction == BST_FORWARD;
+	NODE *cur = pIter -> tree -> root;
+
+	pIter -> top = 0;
+	if(k < 0) return 1;
+
+	// _iterSeek 과 같지만 키 대신 진행 방향 반대쪽 서브트리의 크기로 내려감
+	while(cur != NULL){
+		NODE *near = forward ? cur -> left : cur -> right;
+		int nearSize = near != NULL ? near -> size : 0;
+
+		if(k <= nearSize){
+			if(!_iterPush(pIter, cur)) return 0;
+			if(k == nearSize) break;
+			cur = near;
+		}
+		else{
+			k -= nearSize + 1;
+			cur = forward ? cur -> right : cur -> left;
+		}
+	}
+	return 1;
+}
+
+/* returns data at the current position and advances iterator (amortized O(1))
+	return	address of data
+			NULL if no more data (또는 스택 overflow)
+*/
+void *BST_IterNext( ITER *pIter){
+	NODE *node = _iterStep(pIter);
+
+	return node != NULL ? node -> dataPtr : NULL;
+}
+
+/* returns data at the current position without advancing
+	return	address of data
+			NULL if no more data
+*/
+void *BST_IterPeek( ITER *pIter){
+	if(pIter -> top == 0) return NULL;
+	return pIter -> stack[pIter -> top - 1] -> dataPtr;
+}
 
 /* Print tree using right-to-left inorder traversal with level
 */
-void printTree( TREE *pTree, void (*callback)(const void *));
+void printTree( TREE *pTree, void (*callback)(const void *)){
+	_inorder_print(pTree -> root, 0, callback);
+}
 
 /* returns number of nodes in tree
 */
-int BST_Count( TREE *pTree);
+int BST_Count( TREE *pTree){
+	return pTree -> count;
+}
+
+/* returns height of tree (empty tree = 0)
+*/
+int BST_Height( TREE *pTree){
+	if(pTree -> mode == BST_AVL){
+		return pTree -> root == NULL ? 0 : pTree -> root -> height;
+	}
+	return _getHeight(pTree -> root);
+}
 
+/* returns number of data less than keyPtr in O(log n)
+	keyPtr 이 트리에 있으면 정렬 순서에서의 위치 (0-based)
+*/
+int BST_Rank( TREE *pTree, void *keyPtr){
+	return _rank(pTree, keyPtr, 0);
+}
 
-// internal functions (not mandatory)
-// used in BST_Insert
-static int _insert( NODE *root, NODE *newPtr, int (*compare)(const void *, const void *), void (*callback)(void *)){
-	int cmp = compare(newPtr -> dataPtr, root -> dataPtr);
+/* Retrieve the k-th smallest data in O(log n) (0-based, BST_Rank 의 역)
+	return	address of data
+			NULL if k < 0 or k >= count
+*/
+void *BST_Select( TREE *pTree, int k){
+	NODE *cur = pTree -> root;
 
-	if(cmp < 0){
-		if(root -> left == NULL){
-			root -> left = newPtr;
-		}
+	if(k < 0 || k >= pTree -> count) return NULL;
+
+	while(cur != NULL){
+		int leftSize = cur -> left != NULL ? cur -> left -> size : 0;
+
+		if(k < leftSize) cur = cur -> left;
+		else if(k == leftSize) return cur -> dataPtr;
 		else{
-			return _insert(root -> left, newPtr, compare, callback);
+			k -= leftSize + 1;
+			cur = cur -> right;
+		}
+	}
+	return NULL;
+}
+
+/* returns number of data d with loPtr <= d <= hiPtr in O(log n) (loPtr > hiPtr 이면 0)
+*/
+int BST_RangeCount( TREE *pTree, void *loPtr, void *hiPtr){
+	int count = _rank(pTree, hiPtr, 1) - _rank(pTree, loPtr, 0);
+
+	return count > 0 ? count : 0;
+}
+
+/* Selects the first k data in order (compare 와 다른 순서, 예: 빈도순) without sorting the whole tree
+	트리를 한 번 순회하며 크기 k 의 힙만 유지 (O(n log k), 추가 메모리는 순회 스택뿐)
+	트리를 바꾸지 않으므로 읽기 연산으로 취급 (BST_Search 와 동시에 호출 가능)
+	dataOutPtr	data k 개를 저장할 배열, order 순서로 채움
+	return	저장한 data 수 (트리가 k 개보다 적으면 BST_Count)
+			-1 if overflow
+*/
+int BST_TopK( TREE *pTree, int k, int (*order)(const void *, const void *), void **dataOutPtr){
+	ITER iter;
+	NODE *node;
+	int n = 0;
+	int visited = 0;
+
+	// _traverse 와 같은 스택 순회 (순서는 상관없음, 트리를 바꾸지 않으므로 BST_Search 와 동시에 실행 가능)
+	if(!_iterInit(&iter, pTree, BST_FORWARD)) return -1;
+
+	while((node = _iterStep(&iter)) != NULL){
+		_heapOffer(dataOutPtr, &n, k, node -> dataPtr, order);
+		visited++;
+	}
+	free(iter.stack);
+	if(visited != pTree -> count) return -1;
+
+	// 힙 정렬: 루트(가장 뒤)를 끝으로 보내며 앞쪽만 다시 힙으로
+	for(int i = n - 1; i > 0; i--){
+		void *temp = dataOutPtr[0];
+		dataOutPtr[0] = dataOutPtr[i];
+		dataOutPtr[i] = temp;
+		_heapDown(dataOutPtr, i, 0, order);
+	}
+	return n;
+}
+
+/* Sets a key prefix function (NULL to disable), 이미 있는 노드의 prefix 도 다시 계산
+	prefix	데이터의 앞 8 바이트를 big-endian 정수로 만든 값 (예: BST_StringPrefix)
+			prefix(a) < prefix(b) 이면 compare(a, b) < 0 이어야 함
+	return	1 success
+			0 overflow
+*/
+int BST_SetPrefix( TREE *pTree, uint64_t (*prefix)(const void *)){
+	NODE **nodes = malloc(sizeof(NODE *) * (pTree -> count > 0 ? pTree -> count : 1));
+	if(nodes == NULL) return 0;
+
+	if(!_flatten(pTree, nodes)){
+		free(nodes);
+		return 0;
+	}
+
+	pTree -> prefix = prefix;
+	for(int i = 0; i < pTree -> count; i++){
+		nodes[i] -> prefix = prefix != NULL ? prefix(nodes[i] -> dataPtr) : 0;
+	}
+
+	free(nodes);
+	return 1;
+}
+
+/* returns first 8 bytes of a C string as a big-endian integer ('\0' 뒤는 0)
+	strcmp 순서의 트리에서 BST_SetPrefix 에 사용
+*/
+uint64_t BST_StringPrefix( const void *str){
+	const unsigned char *s = str;
+	uint64_t prefix = 0;
+
+	for(int i = 0; i < 8; i++){
+		prefix <<= 8;
+		if(*s != '\0') prefix |= *s++;
+	}
+	return prefix;
+}
+
+/* Builds a perfectly balanced tree from sorted data in O(n)
+	sorted	data 배열 (compare 기준 strictly ascending, 중복 없음)
+	mode	BST_PLAIN or BST_AVL (노드는 항상 한 슬랩에 연속으로 할당, BST_POOL 과 같음)
+	return	head node pointer
+			NULL if overflow, unknown mode or sorted is not strictly ascending
+*/
+TREE *BST_BuildFromSorted( int (*compare)(const void *, const void *), int mode, void **sorted, int n){
+	return _build(compare, mode, n, sorted, NULL, NULL);
+}
+
+/* BST_BuildFromSorted 와 같지만 data 를 next(ctx) 로 n개 차례로 받음 (정렬된 스냅샷, print_dic 출력 등)
+	return	head node pointer
+			NULL if overflow, unknown mode, next returned NULL or data is not strictly ascending
+*/
+TREE *BST_BuildFromIter( int (*compare)(const void *, const void *), int mode, int n, void *(*next)(void *), void *ctx){
+	return _build(compare, mode, n, NULL, next, ctx);
+}
+
+/* Rebuilds the tree in place as a perfectly balanced tree in O(n) (기존 노드를 다시 연결, data 는 그대로)
+	return	1 success
+			0 overflow
+*/
+int BST_Rebalance( TREE *pTree){
+	NODE **nodes = malloc(sizeof(NODE *) * (pTree -> count > 0 ? pTree -> count : 1));
+	if(nodes == NULL) return 0;
+
+	if(!_flatten(pTree, nodes)){
+		free(nodes);
+		return 0;
+	}
+	pTree -> root = _link(nodes, pTree -> count);
+
+	free(nodes);
+	return 1;
+}
+
+/* Builds a read-only search snapshot of the tree (tree is not modified, 읽기 락으로 충분)
+	snapshot 은 dataPtr 만 공유하므로 이후 트리의 삽입/삭제는 반영되지 않음
+	return	snapshot pointer
+			NULL if overflow
+*/
+FROZEN *BST_Freeze( TREE *pTree){
+	int n = pTree -> count;
+	FROZEN *pFrozen = malloc(sizeof(FROZEN));
+	if(pFrozen == NULL) return NULL;
+
+	// keys[0] 을 비워 두므로 n + 1 개, aligned_alloc 의 크기는 정렬의 배수
+	size_t size = (sizeof(void *) * (n + 1) + 63) / 64 * 64;
+	NODE **sorted = malloc(sizeof(NODE *) * (n > 0 ? n : 1));
+	pFrozen -> keys = aligned_alloc(64, size);
+	if(sorted == NULL || pFrozen -> keys == NULL){
+		free(sorted);
+		free(pFrozen -> keys);
+		free(pFrozen);
+		return NULL;
+	}
+
+	if(!_flatten(pTree, sorted)){
+		free(sorted);
+		free(pFrozen -> keys);
+		free(pFrozen);
+		return NULL;
+	}
+	_eytzinger(sorted, pFrozen -> keys, n);
+	free(sorted);
+
+	pFrozen -> keys[0] = NULL;
+	pFrozen -> count = n;
+	pFrozen -> compare = pTree -> compare;
+	return pFrozen;
+}
+
+/* Retrieve snapshot for the data containing the requested key (BST_Search 와 같은 결과)
+	비교 결과로 다음 인덱스를 계산하며 내려가고, 마지막에 한 번만 일치 여부를 확인
+	return	address of data containing the key
+			NULL not found
+*/
+void *BST_SearchFrozen( FROZEN *pFrozen, void *keyPtr){
+	void **keys = pFrozen -> keys;
+	size_t n = pFrozen -> count;
+	size_t k = 1;
+
+	while(k <= n){
+		PREFETCH(keys + k * FROZEN_LINE);
+		// 두 자식의 데이터(키 문자열 등)도 미리 읽음 (마지막 레벨에서는 건너뜀)
+		if(2 * k + 1 <= n){
+			PREFETCH(keys[2 * k]);
+			PREFETCH(keys[2 * k + 1]);
 		}
+		k = 2 * k + (pFrozen -> compare(keyPtr, keys[k]) > 0);
+	}
+
+	// 마지막으로 왼쪽으로 내려간 위치 = keyPtr 이상인 첫 데이터 (k 의 끝에 붙은 1 비트들과 0 비트 하나를 제거)
+	while(k & 1){
+		k >>= 1;
 	}
-	else if(cmp > 0){
-		if(root -> right == NULL){
-			root -> right = newPtr;
+	k >>= 1;
+
+	if(k == 0 || pFrozen -> compare(keyPtr, keys[k]) != 0) return NULL;
+	return keys[k];
+}
+
+/* Deletes snapshot (data 는 해제하지 않음)
+*/
+void BST_DestroyFrozen( FROZEN *pFrozen){
+	free(pFrozen -> keys);
+	free(pFrozen);
+}
+
+
+// internal functions (not mandatory)
+// 모든 내부 함수는 재귀 없이 반복문으로 동작 (트리 깊이에 따른 스택 제한 없음)
+
+// used in BST_Insert
+// 높이 제한이 없어 경로를 저장할 수 없으므로, 새 노드를 연결한 뒤 루트에서 다시 내려가며 size 를 늘림
+// (중복 키일 때는 추가 비교 없음)
+static int _insert( TREE *pTree, NODE *newPtr, void (*callback)(void *)){
+	NODE *cur = pTree -> root;
+
+	while(1){
+		int cmp = _compare(pTree, newPtr -> dataPtr, newPtr -> prefix, cur);
+
+		if(cmp < 0){
+			if(cur -> left == NULL){
+				cur -> left = newPtr;
+				break;
+			}
+			cur = cur -> left;
+		}
+		else if(cmp > 0){
+			if(cur -> right == NULL){
+				cur -> right = newPtr;
+				break;
+			}
+			cur = cur -> right;
 		}
 		else{
-			return _insert(root -> right, newPtr, compare, callback);
+			callback(cur -> dataPtr);
+			return 2;
 		}
 	}
-	else{
-		callback(newPtr -> dataPtr);
-		return 2;
+
+	for(cur = pTree -> root; cur != newPtr; ){
+		cur -> size++;
+		cur = _compare(pTree, newPtr -> dataPtr, newPtr -> prefix, cur) < 0 ? cur -> left : cur -> right;
 	}
 	return 1;
 }
 
-// used in BST_Insert
-static NODE *_makeNode( void *dataInPtr){
-	NODE *newnode = (NODE *)malloc(sizeof(NODE));
+// used in BST_Insert (BST_AVL mode)
+// 내려가면서 지나온 링크를 스택에 저장하고, 삽입 후 높이가 변하지 않는 지점까지 거슬러 올라가며 균형을 맞춤
+// 그 위의 조상은 회전 없이 size 만 늘림
+// result	1 success, 2 if duplicated key
+// return	pointer to (rebalanced) root
+static NODE *_insertAVL( TREE *pTree, NODE *newPtr, void (*callback)(void *), int *result){
+	NODE *root = pTree -> root;
+	NODE **path[BST_MAX_HEIGHT];
+	int top = 0;
+	NODE **link = &root;
+
+	while(*link != NULL){
+		int cmp = _compare(pTree, newPtr -> dataPtr, newPtr -> prefix, *link);
+
+		if(cmp == 0){
+			callback((*link) -> dataPtr);
+			*result = 2;
+			return root;
+		}
+		path[top++] = link;
+		link = cmp < 0 ? &(*link) -> left : &(*link) -> right;
+	}
+	*link = newPtr;
+	*result = 1;
+
+	while(top > 0){
+		link = path[--top];
+
+		int oldHeight = (*link) -> height;
+		*link = _balance(*link);
+		if((*link) -> height == oldHeight) break;
+	}
+	while(top > 0){
+		(*path[--top]) -> size++;
+	}
+	return root;
+}
+
+// used in BST_Insert, _build
+// pool 이 있으면 풀에서, 없으면 malloc 으로 할당
+static NODE *_makeNode( TREE *pTree, void *dataInPtr){
+	NODE *newnode = pTree -> pool != NULL ? (NODE *)POOL_Alloc(pTree -> pool) : (NODE *)malloc(sizeof(NODE));
 	if(newnode == NULL) return NULL;
 
 	newnode -> dataPtr = dataInPtr;
+	newnode -> prefix = pTree -> prefix != NULL ? pTree -> prefix(dataInPtr) : 0;
 	newnode -> left = NULL;
 	newnode -> right = NULL;
+	newnode -> height = 1;
+	newnode -> size = 1;
 
 	return newnode;
 }
 
+// used in BST_Insert, _delete
+static void _freeNode( POOL *pool, NODE *node){
+	if(pool != NULL){
+		POOL_Free(pool, node);
+	}
+	else{
+		free(node);
+	}
+}
+
 // used in BST_Destroy
-static void _destroy( NODE *root, void (*callback)(void *)){
-    if(root == NULL) return;
-    _destroy(root -> left, callback);
-	_destroy(root -> right, callback);
-	callback(root -> dataPtr);
-	free(root);
+// 왼쪽 자식이 있으면 오른쪽으로 회전시켜 왼쪽 서브트리를 없애고, 없으면 노드를 해제 (추가 메모리 없음)
+// pool 이 있으면 노드는 해제하지 않음 (BST_Destroy 에서 풀 전체를 해제)
+static void _destroy( NODE *root, void (*callback)(void *), POOL *pool){
+	NODE *cur = root;
+
+	while(cur != NULL){
+		if(cur -> left != NULL){
+			NODE *left = cur -> left;
+			cur -> left = left -> right;
+			left -> right = cur;
+			cur = left;
+		}
+		else{
+			NODE *next = cur -> right;
+			callback(cur -> dataPtr);
+			if(pool == NULL) free(cur);
+			cur = next;
+		}
+	}
 }
 
 // used in BST_Delete
+// BST_AVL 모드에서는 지나온 링크를 스택에 저장해 두었다가 아래에서부터 균형을 맞춤
+// 지나온 노드의 size 는 내려가면서 줄이고, 키가 없으면 다시 내려가며 되돌림
 // return 	pointer to root
-static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)(const void *, const void *)){
-	if(root == NULL) return NULL;
+static NODE *_delete( TREE *pTree, void *keyPtr, void **dataOutPtr){
+	NODE *root = pTree -> root;
+	int mode = pTree -> mode;
+	POOL *pool = pTree -> pool;
+	uint64_t keyPrefix = pTree -> prefix != NULL ? pTree -> prefix(keyPtr) : 0;
+	NODE **path[BST_MAX_HEIGHT];
+	int top = 0;
+	NODE **link = &root;
 
-	int cmp = compare(keyPtr, root -> dataPtr);
+	while(*link != NULL){
+		int cmp = _compare(pTree, keyPtr, keyPrefix, *link);
 
-	if(cmp < 0){
-		root -> left = _delete(root -> left, keyPtr, dataOutPtr, compare);
+		if(cmp == 0) break;
+		if(mode == BST_AVL) path[top++] = link;
+		(*link) -> size--;
+		link = cmp < 0 ? &(*link) -> left : &(*link) -> right;
 	}
-	else if(cmp > 0){
-		root -> right = _delete(root -> right, keyPtr, dataOutPtr, compare);
-	}
-	else{
-		*dataOutPtr = root -> dataPtr;
-		if(root -> left == NULL && root -> right == NULL){
-			free(root);
-			return NULL;
-		}
-		else if(root -> right == NULL){
-			NODE *temp = root -> left;
-			free(root);
-			return temp;
+	if(*link == NULL){
+		for(NODE *cur = root; cur != NULL; ){
+			cur -> size++;
+			cur = _compare(pTree, keyPtr, keyPrefix, cur) < 0 ? cur -> left : cur -> right;
 		}
+		return root;
+	}
 
-		else if(root -> left == NULL){
-			NODE *temp = root -> right;
-			free(root);
-			return temp;
-		}
-		
-		else{
-			NODE *minright = root -> right;
-			while(minright -> left != NULL){
-				minright = minright -> left;
-			}
-			root -> dataPtr = minright -> dataPtr;
-			root -> right = _delete(root -> left, minright -> dataPtr, dataOutPtr, compare);
+	NODE *target = *link;
+	*dataOutPtr = target -> dataPtr;
+
+	if(target -> left != NULL && target -> right != NULL){
+		// 후속자(오른쪽 서브트리의 최소값)를 이 노드로 옮기고 후속자 노드를 제거
+		if(mode == BST_AVL) path[top++] = link;
+		target -> size--;
+
+		NODE **minLink = &target -> right;
+		while((*minLink) -> left != NULL){
+			if(mode == BST_AVL) path[top++] = minLink;
+			(*minLink) -> size--;
+			minLink = &(*minLink) -> left;
 		}
+		NODE *minright = *minLink;
+		target -> dataPtr = minright -> dataPtr;
+		target -> prefix = minright -> prefix;
+		*minLink = minright -> right;
+		_freeNode(pool, minright);
+	}
+	else{
+		*link = target -> left != NULL ? target -> left : target -> right;
+		_freeNode(pool, target);
+	}
+
+	while(top > 0){
+		link = path[--top];
+		*link = _balance(*link);
 	}
 	return root;
 }
@@ -198,28 +720,471 @@ static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare
 // Retrieve node containing the requested key
 // return	address of the node containing the key
 //			NULL not found
-static NODE *_search( NODE *root, void *keyPtr, int (*compare)(const void *, const void *)){
-	if(root == NULL) return NULL;
+static NODE *_search( TREE *pTree, void *keyPtr){
+	uint64_t keyPrefix = pTree -> prefix != NULL ? pTree -> prefix(keyPtr) : 0;
+	NODE *cur = pTree -> root;
 
-	int cmp = compare(keyPtr, root -> dataPtr );
+	while(cur != NULL){
+		int cmp = _compare(pTree, keyPtr, keyPrefix, cur);
 
-	if(cmp == 0){
-		return root;
+		if(cmp == 0) return cur;
+		cur = cmp < 0 ? cur -> left : cur -> right;
 	}
-	else if(cmp < 0){
-		return _search(root -> left, keyPtr, compare);
+	return NULL;
+}
+
+// used in BST_Traverse, BST_TraverseR
+// BST_IterNext 와 같은 명시적 스택으로 순회 (트리의 링크를 바꾸지 않으므로 읽기 연산과 동시에 실행 가능)
+// 스택을 늘리지 못하면 거기서 멈춤
+static void _traverse( TREE *pTree, int direction, void (*callback)(const void *)){
+	ITER iter;
+	NODE *node;
+
+	if(!_iterInit(&iter, pTree, direction)) return;
+
+	while((node = _iterStep(&iter)) != NULL){
+		callback(node -> dataPtr);
 	}
-	else{
-		return _search(root -> right, keyPtr, compare);
+	free(iter.stack);
+}
+
+// used in BST_Freeze, BST_Rebalance, BST_SetPrefix
+// 중위 순회 순서(정렬 순서)로 노드를 out 에 저장 (_traverse 와 같은 스택 순회, 트리는 바꾸지 않음)
+// return	1 success
+//			0 overflow
+static int _flatten( TREE *pTree, NODE **out){
+	ITER iter;
+	NODE *node;
+	int n = 0;
+
+	if(!_iterInit(&iter, pTree, BST_FORWARD)) return 0;
+
+	while((node = _iterStep(&iter)) != NULL){
+		out[n++] = node;
+	}
+	free(iter.stack);
+
+	// 스택을 늘리지 못해 중간에 멈춤
+	return n == pTree -> count;
+}
+
+// used in BST_Freeze
+// 정렬된 sorted[0..n-1] 의 data 를 keys[1..n] 의 Eytzinger 순서로 배치
+// 암시적 완전 이진 트리를 중위 순회하며 차례로 채움 (재귀 없음)
+static void _eytzinger( NODE **sorted, void **keys, int n){
+	size_t k = 1;
+
+	if(n == 0) return;
+
+	while(2 * k <= (size_t)n) k = 2 * k; // 가장 왼쪽 노드
+
+	for(int i = 0; i < n; i++){
+		keys[k] = sorted[i] -> dataPtr;
+
+		// 중위 후속자: 오른쪽 서브트리의 가장 왼쪽, 없으면 왼쪽 자식으로 올라온 첫 조상
+		if(2 * k + 1 <= (size_t)n){
+			k = 2 * k + 1;
+			while(2 * k <= (size_t)n) k = 2 * k;
+		}
+		else{
+			while(k & 1) k >>= 1;
+			k >>= 1;
+		}
+	}
+}
+
+// used in _build, BST_Rebalance
+// 정렬 순서의 nodes[0..n-1] 을 가운데 원소를 루트로 하는 완전 균형 트리로 연결
+// 구간 [lo, hi) 를 명시적 스택으로 나눔 (스택 깊이 <= 트리 높이 + 1)
+// 크기 m 인 구간의 높이는 m 의 비트 수이므로 BST_AVL 의 height 와 size 도 바로 채움
+// return	root
+static NODE *_link( NODE **nodes, int n){
+	struct{
+		int		lo, hi;
+		NODE	**link;
+	} stack[BST_MAX_HEIGHT];
+	int top = 0;
+	NODE *root = NULL;
+
+	stack[top].lo = 0;
+	stack[top].hi = n;
+	stack[top].link = &root;
+	top++;
+
+	while(top > 0){
+		top--;
+		int lo = stack[top].lo;
+		int hi = stack[top].hi;
+		NODE **link = stack[top].link;
+
+		if(lo >= hi){
+			*link = NULL;
+			continue;
+		}
+
+		int mid = lo + (hi - lo) / 2;
+		NODE *node = nodes[mid];
+		*link = node;
+
+		int height = 0;
+		for(int m = hi - lo; m > 0; m >>= 1) height++;
+		node -> height = height;
+		node -> size = hi - lo;
+
+		stack[top].lo = mid + 1;
+		stack[top].hi = hi;
+		stack[top].link = &node -> right;
+		top++;
+		stack[top].lo = lo;
+		stack[top].hi = mid;
+		stack[top].link = &node -> left;
+		top++;
+	}
+	return root;
+}
+
+// used in BST_BuildFromSorted, BST_BuildFromIter
+// data 는 sorted 배열 또는 next(ctx) 에서 차례로 받음
+// 노드 n개를 풀의 슬랩 하나에서 연속으로 할당한 뒤 _link 로 연결
+// return	head node pointer
+//			NULL if overflow, unknown mode or data is not strictly ascending
+static TREE *_build( int (*compare)(const void *, const void *), int mode, int n, void **sorted, void *(*next)(void *), void *ctx){
+	TREE *pTree = BST_CreateEx(compare, mode | BST_POOL);
+	if(pTree == NULL) return NULL;
+
+	NODE **nodes = malloc(sizeof(NODE *) * (n > 0 ? n : 1));
+	if(nodes == NULL){
+		BST_Destroy(pTree, NULL);
+		return NULL;
 	}
+
+	// n개 노드를 한 슬랩에 연속으로 잡음 (이후 BST_Insert 용 슬랩은 기본 크기)
+	if(!POOL_Reserve(pTree -> pool, n)){
+		free(nodes);
+		BST_Destroy(pTree, NULL);
+		return NULL;
+	}
+
+	int i;
+	for(i = 0; i < n; i++){
+		void *data = sorted != NULL ? sorted[i] : next(ctx);
+		if(data == NULL) break;
+		if(i > 0 && compare(nodes[i - 1] -> dataPtr, data) >= 0) break;
+
+		nodes[i] = _makeNode(pTree, data);
+		if(nodes[i] == NULL) break;
+	}
+
+	if(i < n){
+		free(nodes);
+		BST_Destroy(pTree, NULL); // 노드는 풀과 함께 해제, data 는 호출자 소유
+		return NULL;
+	}
+
+	pTree -> root = _link(nodes, n);
+	pTree -> count = n;
+
+	free(nodes);
+	return pTree;
+}
+
+// used in BST_IterCreate, _traverse
+// 반복자의 스택을 할당하고 direction 쪽 첫 노드에 위치시킴
+// return	1 success
+//			0 overflow (스택은 해제됨)
+static int _iterInit( ITER *pIter, TREE *pTree, int direction){
+	pIter -> stack = malloc(sizeof(NODE *) * BST_MAX_HEIGHT);
+	if(pIter -> stack == NULL) return 0;
+
+	pIter -> tree = pTree;
+	pIter -> direction = direction;
+	pIter -> top = 0;
+	pIter -> capacity = BST_MAX_HEIGHT;
+
+	if(!_iterDescend(pIter, pTree -> root)){
+		free(pIter -> stack);
+		return 0;
+	}
+	return 1;
 }
 
-// used in BST_Traverse
-static void _traverse( NODE *root, void (*callback)(const void *));
+// used in BST_IterNext, _traverse
+// 스택 top 의 노드를 꺼내고 다음 노드까지 스택에 쌓음
+// 다음 노드: 진행 방향 쪽 서브트리의 가장 먼 노드, 없으면 스택에 남은 조상
+// return	꺼낸 노드
+//			NULL if no more node (또는 스택 overflow)
+static NODE *_iterStep( ITER *pIter){
+	if(pIter -> top == 0) return NULL;
 
-// used in BST_TraverseR
-static void _traverseR( NODE *root, void (*callback)(const void *));
+	NODE *node = pIter -> stack[--pIter -> top];
+
+	if(!_iterDescend(pIter, pIter -> direction == BST_FORWARD ? node -> right : node -> left)){
+		pIter -> top = 0;
+		return NULL;
+	}
+	return node;
+}
+
+// used in _iterDescend, _iterSeek
+// BST_PLAIN 트리는 높이 제한이 없으므로 스택이 차면 두 배로 늘림
+// return	1 success
+//			0 overflow
+static int _iterPush( ITER *pIter, NODE *node){
+	if(pIter -> top == pIter -> capacity){
+		NODE **stack = realloc(pIter -> stack, sizeof(NODE *) * pIter -> capacity * 2);
+		if(stack == NULL) return 0;
+
+		pIter -> stack = stack;
+		pIter -> capacity *= 2;
+	}
+	pIter -> stack[pIter -> top++] = node;
+	return 1;
+}
+
+// used in BST_IterFirst, _iterInit, _iterStep
+// cur 부터 진행 방향의 반대쪽(BST_FORWARD 이면 왼쪽)으로 끝까지 내려가며 스택에 쌓음
+// return	1 success
+//			0 overflow
+static int _iterDescend( ITER *pIter, NODE *cur){
+	while(cur != NULL){
+		if(!_iterPush(pIter, cur)) return 0;
+		cur = pIter -> direction == BST_FORWARD ? cur -> left : cur -> right;
+	}
+	return 1;
+}
+
+// used in BST_IterLowerBound, BST_IterUpperBound
+// 루트에서 keyPtr 쪽으로 한 번 내려가면서, 진행 방향으로 keyPtr 을 지나지 않은 노드만 쌓음
+// 쌓인 노드는 돌려줄 순서대로 놓이므로 스택 top 이 경계의 첫 노드
+//	inclusive	1 이면 keyPtr 과 같은 노드도 포함
+// return	1 success
+//			0 overflow
+static int _iterSeek( ITER *pIter, void *keyPtr, int inclusive){
+	TREE *pTree = pIter -> tree;
+	uint64_t keyPrefix = pTree -> prefix != NULL ? pTree -> prefix(keyPtr) : 0;
+	NODE *cur = pTree -> root;
+
+	pIter -> top = 0;
+	while(cur != NULL){
+		int cmp = _compare(pTree, keyPtr, keyPrefix, cur);
+
+		if(pIter -> direction == BST_BACKWARD) cmp = -cmp;
+		if(cmp < 0 || (cmp == 0 && inclusive)){
+			if(!_iterPush(pIter, cur)) return 0;
+			if(cmp == 0) break; // keyPtr 보다 앞선 노드는 이 노드의 왼쪽(BACKWARD 는 오른쪽) 서브트리에만 있음
+			cur = pIter -> direction == BST_FORWARD ? cur -> left : cur -> right;
+		}
+		else{
+			cur = pIter -> direction == BST_FORWARD ? cur -> right : cur -> left;
+		}
+	}
+	return 1;
+}
+
+// used in BST_Rank, BST_RangeCount
+// 지나온 노드 중 keyPtr 보다 작은 노드와 그 왼쪽 서브트리의 크기를 더함
+//	inclusive	1 이면 keyPtr 과 같은 data 도 셈
+// return	number of data less than (or equal to) keyPtr
+static int _rank( TREE *pTree, void *keyPtr, int inclusive){
+	uint64_t keyPrefix = pTree -> prefix != NULL ? pTree -> prefix(keyPtr) : 0;
+	NODE *cur = pTree -> root;
+	int rank = 0;
+
+	while(cur != NULL){
+		int cmp = _compare(pTree, keyPtr, keyPrefix, cur);
+		int leftSize = cur -> left != NULL ? cur -> left -> size : 0;
+
+		if(cmp < 0){
+			cur = cur -> left;
+		}
+		else if(cmp > 0){
+			rank += leftSize + 1;
+			cur = cur -> right;
+		}
+		else{
+			rank += leftSize + inclusive;
+			break;
+		}
+	}
+	return rank;
+}
+
+// used in BST_TopK
+// heap[0..n-1] 은 order 기준 max-heap (루트가 지금까지 고른 data 중 order 순서로 가장 뒤)
+// 힙이 k 개 미만이면 추가, 가득 차 있으면 루트보다 앞서는 data 만 루트와 바꿈
+static void _heapOffer( void **heap, int *n, int k, void *dataPtr, int (*order)(const void *, const void *)){
+	if(*n < k){
+		int i = (*n)++;
+
+		while(i > 0 && order(heap[(i - 1) / 2], dataPtr) < 0){
+			heap[i] = heap[(i - 1) / 2];
+			i = (i - 1) / 2;
+		}
+		heap[i] = dataPtr;
+	}
+	else if(k > 0 && order(dataPtr, heap[0]) < 0){
+		heap[0] = dataPtr;
+		_heapDown(heap, *n, 0, order);
+	}
+}
+
+// used in BST_TopK, _heapOffer
+// heap[i] 를 order 순서로 더 뒤인 자식과 비교하며 아래로 내림
+static void _heapDown( void **heap, int n, int i, int (*order)(const void *, const void *)){
+	void *item = heap[i];
+
+	while(2 * i + 1 < n){
+		int child = 2 * i + 1;
+
+		if(child + 1 < n && order(heap[child + 1], heap[child]) > 0) child++;
+		if(order(item, heap[child]) >= 0) break;
+		heap[i] = heap[child];
+		i = child;
+	}
+	heap[i] = item;
+}
+
+// used in _inorder_print, _getHeight
+// 스택을 두 배로 늘림
+// return	새 스택, NULL if overflow (기존 스택은 해제됨)
+static FRAME *_growStack( FRAME *stack, int *capacity){
+	FRAME *newStack = realloc(stack, sizeof(FRAME) * *capacity * 2);
+
+	if(newStack == NULL){
+		free(stack);
+		return NULL;
+	}
+	*capacity *= 2;
+	return newStack;
+}
 
 // used in printTree
-static void _inorder_print( NODE *root, int level, void (*callback)(const void *));
+// level 만큼 탭으로 들여쓴 뒤 출력 (오른쪽 서브트리부터)
+static void _inorder_print( NODE *root, int level, void (*callback)(const void *)){
+	int capacity = BST_MAX_HEIGHT;
+	int top = 0;
+	FRAME *stack = malloc(sizeof(FRAME) * capacity);
+	if(stack == NULL) return;
+
+	NODE *cur = root;
+	while(cur != NULL || top > 0){
+		while(cur != NULL){
+			if(top == capacity && (stack = _growStack(stack, &capacity)) == NULL) return;
+			stack[top].node = cur;
+			stack[top].level = level;
+			top++;
+			cur = cur -> right;
+			level++;
+		}
+		top--;
+		cur = stack[top].node;
+		level = stack[top].level;
+
+		for(int i = 0; i < level; i++){
+			printf("\t");
+		}
+		callback(cur -> dataPtr);
+
+		cur = cur -> left;
+		level++;
+	}
+	free(stack);
+}
+
+// used in BST_Height (BST_PLAIN mode)
+// return	height, -1 if overflow
+static int _getHeight( NODE *root){
+	int capacity = BST_MAX_HEIGHT;
+	int top = 0;
+	int height = 0;
+	FRAME *stack = malloc(sizeof(FRAME) * capacity);
+	if(stack == NULL) return -1;
+
+	if(root != NULL){
+		stack[top].node = root;
+		stack[top].level = 1;
+		top++;
+	}
+	while(top > 0){
+		top--;
+		NODE *cur = stack[top].node;
+		int level = stack[top].level;
+
+		if(level > height) height = level;
+
+		if(top + 2 > capacity && (stack = _growStack(stack, &capacity)) == NULL) return -1;
+		if(cur -> left != NULL){
+			stack[top].node = cur -> left;
+			stack[top].level = level + 1;
+			top++;
+		}
+		if(cur -> right != NULL){
+			stack[top].node = cur -> right;
+			stack[top].level = level + 1;
+			top++;
+		}
+	}
+	free(stack);
+	return height;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AVL helpers
+
+static int _height( NODE *root){
+	return root == NULL ? 0 : root -> height;
+}
 
+// 높이와 함께 size 도 자식에서 다시 계산 (회전, _balance 후 order statistic 유지)
+static void _updateHeight( NODE *root){
+	int lh = _height(root -> left);
+	int rh = _height(root -> right);
+
+	root -> height = (lh > rh ? lh : rh) + 1;
+	root -> size = (root -> left != NULL ? root -> left -> size : 0) + (root -> right != NULL ? root -> right -> size : 0) + 1;
+}
+
+static NODE *_rotateRight( NODE *root){
+	NODE *newRoot = root -> left;
+
+	root -> left = newRoot -> right;
+	newRoot -> right = root;
+
+	_updateHeight(root);
+	_updateHeight(newRoot);
+	return newRoot;
+}
+
+static NODE *_rotateLeft( NODE *root){
+	NODE *newRoot = root -> right;
+
+	root -> right = newRoot -> left;
+	newRoot -> left = root;
+
+	_updateHeight(root);
+	_updateHeight(newRoot);
+	return newRoot;
+}
+
+// used in _insertAVL, _delete
+// 높이를 갱신하고 균형 인수가 2 이상이면 회전
+// return	pointer to (rebalanced) root
+static NODE *_balance( NODE *root){
+	_updateHeight(root);
+
+	int bf = _height(root -> left) - _height(root -> right);
+
+	if(bf > 1){
+		if(_height(root -> left -> left) < _height(root -> left -> right)){
+			root -> left = _rotateLeft(root -> left); // LR
+		}
+		return _rotateRight(root);
+	}
+	if(bf < -1){
+		if(_height(root -> right -> right) < _height(root -> right -> left)){
+			root -> right = _rotateRight(root -> right); // RL
+		}
+		return _rotateLeft(root);
+	}
+	return root;
+}
@@ -1,3 +1,7 @@
+#include <stdint.h> // uint64_t
+
+#include "../common/node_pool.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 // TREE type definition
 typedef struct node
@@ -5,25 +9,72 @@ typedef struct node
 	void		*dataPtr;
 	struct node	*left;
 	struct node	*right;
+	int			height;	// 서브트리 높이 (BST_AVL 모드에서만 유지, leaf = 1)
+	int			size;	// 서브트리의 노드 수 (자신 포함, BST_Rank / BST_Select 에 사용)
+	uint64_t	prefix;	// 데이터의 key prefix (BST_SetPrefix), 다르면 compare 를 호출하지 않고 결정
 } NODE;
 
+// balancing modes (BST_CreateEx)
+#define BST_PLAIN	0	// 균형을 맞추지 않는 일반 이진 탐색 트리
+#define BST_AVL		1	// AVL 트리 (최악의 경우에도 높이 O(log n))
+
+// allocation flag (BST_CreateEx, balancing mode 와 OR 로 조합)
+#define BST_POOL	0x10	// 노드를 슬랩 메모리 풀에서 할당, BST_Destroy 에서 한 번에 해제
+
 typedef struct
 {
 	int	count;
 	NODE	*root;
-	int	(*compare)(const void *, const void *); 
+	int	(*compare)(const void *, const void *);
+	int	mode;	// BST_PLAIN or BST_AVL
+	POOL	*pool;	// node pool (NULL if nodes are allocated by malloc)
+	uint64_t	(*prefix)(const void *);	// key prefix function (NULL if not used)
 } TREE;
 
+// 읽기 전용 탐색용 스냅샷 (BST_Freeze)
+// 트리의 dataPtr 를 Eytzinger(BFS) 순서의 배열에 저장: keys[1] = root, keys[k] 의 자식은 keys[2k], keys[2k+1]
+// 포인터를 따라가지 않고 인덱스 계산만으로 내려가므로 다음 레벨들을 미리 prefetch 할 수 있음
+typedef struct
+{
+	int		count;
+	void	**keys;	// keys[1..count] (keys[0] unused), 64-byte 정렬
+	int		(*compare)(const void *, const void *);
+} FROZEN;
+
+// iterator direction (BST_IterCreate)
+#define BST_FORWARD		0	// 오름차순 (BST_Traverse 순서)
+#define BST_BACKWARD	1	// 내림차순 (BST_TraverseR 순서)
+
+// 명시적 스택을 사용하는 중위 순회 반복자 (BST_IterCreate)
+// stack 에는 아직 돌려주지 않은 조상 노드들이 쌓여 있고, stack[top - 1] 이 다음에 돌려줄 노드
+// 트리에 삽입/삭제/BST_Rebalance 를 하면 반복자는 무효가 됨 (BST_IterFirst 또는 seek 으로 다시 위치를 잡아야 함)
+typedef struct
+{
+	TREE	*tree;
+	int		direction;	// BST_FORWARD or BST_BACKWARD
+	int		top;
+	int		capacity;
+	NODE	**stack;
+} ITER;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Prototype declarations
 
 /* Allocates dynamic memory for a tree head node and returns its address to caller
+	same as BST_CreateEx( compare, BST_PLAIN)
 	return	head node pointer
 			NULL if overflow
 */
 TREE *BST_Create( int (*compare)(const void *, const void *));
 
-/* Deletes all data in tree and recycles memory
+/* Allocates dynamic memory for a tree head node with balancing mode
+	mode	BST_PLAIN or BST_AVL, optionally | BST_POOL
+	return	head node pointer
+			NULL if overflow or unknown mode
+*/
+TREE *BST_CreateEx( int (*compare)(const void *, const void *), int mode);
+
+/* Deletes all data in tree and recycles memory (head node, data node, node pool)
 */
 void BST_Destroy( TREE *pTree, void (*callback)(void *));
 
@@ -48,6 +99,8 @@ void *BST_Delete( TREE *pTree, void *keyPtr);
 void *BST_Search( TREE *pTree, void *keyPtr);
 
 /* prints tree using inorder traversal
+	트리를 고치지 않으므로 callback 안에서 BST_Search 같은 읽기 연산을 해도 됨 (삽입/삭제는 안 됨)
+	여러 스레드가 락으로 보호할 때는 읽기 연산으로 취급 (읽기 락으로 충분)
 */
 void BST_Traverse( TREE *pTree, void (*callback)(const void *));
 
@@ -55,6 +108,60 @@ void BST_Traverse( TREE *pTree, void (*callback)(const void *));
 */
 void BST_TraverseR( TREE *pTree, void (*callback)(const void *));
 
+/* Allocates an iterator positioned at the first data (BST_FORWARD: 최솟값, BST_BACKWARD: 최댓값)
+	return	iterator pointer
+			NULL if overflow or unknown direction
+*/
+ITER *BST_IterCreate( TREE *pTree, int direction);
+
+/* Deletes iterator (트리와 data 는 해제하지 않음)
+*/
+void BST_IterDestroy( ITER *pIter);
+
+/* Moves iterator back to the first data in its direction
+	return	1 success
+			0 overflow
+*/
+int BST_IterFirst( ITER *pIter);
+
+/* Moves iterator to the first data not past keyPtr in O(log n)
+	BST_FORWARD		keyPtr 이상인 첫 data (lower_bound)
+	BST_BACKWARD	keyPtr 이하인 마지막 data
+	return	1 success
+			0 overflow
+*/
+int BST_IterLowerBound( ITER *pIter, void *keyPtr);
+
+/* Moves iterator to the first data strictly past keyPtr in O(log n)
+	BST_FORWARD		keyPtr 보다 큰 첫 data (upper_bound)
+	BST_BACKWARD	keyPtr 보다 작은 마지막 data
+	return	1 success
+			0 overflow
+*/
+int BST_IterUpperBound( ITER *pIter, void *keyPtr);
+
+/* Moves iterator to the k-th data in its direction in O(log n) (0-based, 페이지 단위 출력 등)
+	BST_FORWARD 이면 k번째로 작은 data, BST_BACKWARD 이면 k번째로 큰 data
+	k 가 범위를 벗어나면 더 읽을 data 가 없는 상태가 됨
+	return	1 success
+			0 overflow
+*/
+int BST_IterSelect( ITER *pIter, int k);
+
+/* returns data at the current position and advances iterator (amortized O(1))
+	예) "can" 이상 "who" 이하의 단어: BST_IterLowerBound( it, "can");
+		while((p = BST_IterNext( it)) != NULL && compare( p, "who") <= 0) ...
+	return	address of data
+			NULL if no more data (또는 스택 overflow)
+*/
+void *BST_IterNext( ITER *pIter);
+
+/* returns data at the current position without advancing
+	return	address of data
+			NULL if no more data
+*/
+void *BST_IterPeek( ITER *pIter);
+
 /* Print tree using right-to-left inorder traversal with level
 */
 void printTree( TREE *pTree, void (*callback)(const void *));
@@ -63,3 +170,81 @@ void printTree( TREE *pTree, void (*callback)(const void *));
 */
 int BST_Count( TREE *pTree);
 
+/* returns height of tree (empty tree = 0)
+*/
+int BST_Height( TREE *pTree);
+
+/* returns number of data less than keyPtr in O(log n)
+	keyPtr 이 트리에 있으면 정렬 순서에서의 위치 (0-based)
+*/
+int BST_Rank( TREE *pTree, void *keyPtr);
+
+/* Retrieve the k-th smallest data in O(log n) (0-based, BST_Rank 의 역)
+	return	address of data
+			NULL if k < 0 or k >= count
+*/
+void *BST_Select( TREE *pTree, int k);
+
+/* returns number of data d with loPtr <= d <= hiPtr in O(log n) (loPtr > hiPtr 이면 0)
+*/
+int BST_RangeCount( TREE *pTree, void *loPtr, void *hiPtr);
+
+/* Selects the first k data in order (compare 와 다른 순서, 예: 빈도순) without sorting the whole tree
+	트리를 한 번 순회하며 크기 k 의 힙만 유지 (O(n log k), 추가 메모리는 순회 스택뿐)
+	트리를 바꾸지 않으므로 읽기 연산으로 취급 (BST_Search 와 동시에 호출 가능)
+	dataOutPtr	data k 개를 저장할 배열, order 순서로 채움
+	return	저장한 data 수 (트리가 k 개보다 적으면 BST_Count)
+			-1 if overflow
+*/
+int BST_TopK( TREE *pTree, int k, int (*order)(const void *, const void *), void **dataOutPtr);
+
+/* Sets a key prefix function (NULL to disable), 이미 있는 노드의 prefix 도 다시 계산
+	prefix	데이터의 앞 8 바이트를 big-endian 정수로 만든 값 (예: BST_StringPrefix)
+			prefix(a) < prefix(b) 이면 compare(a, b) < 0 이어야 함
+	return	1 success
+			0 overflow
+*/
+int BST_SetPrefix( TREE *pTree, uint64_t (*prefix)(const void *));
+
+/* returns first 8 bytes of a C string as a big-endian integer ('\0' 뒤는 0)
+	strcmp 순서의 트리에서 BST_SetPrefix 에 사용
+*/
+uint64_t BST_StringPrefix( const void *str);
+
+/* Builds a perfectly balanced tree from sorted data in O(n)
+	sorted	data 배열 (compare 기준 strictly ascending, 중복 없음)
+	mode	BST_PLAIN or BST_AVL (노드는 항상 한 슬랩에 연속으로 할당, BST_POOL 과 같음)
+	return	head node pointer
+			NULL if overflow, unknown mode or sorted is not strictly ascending
+*/
+TREE *BST_BuildFromSorted( int (*compare)(const void *, const void *), int mode, void **sorted, int n);
+
+/* BST_BuildFromSorted 와 같지만 data 를 next(ctx) 로 n개 차례로 받음 (정렬된 스냅샷, print_dic 출력 등)
+	return	head node pointer
+			NULL if overflow, unknown mode, next returned NULL or data is not strictly ascending
+*/
+TREE *BST_BuildFromIter( int (*compare)(const void *, const void *), int mode, int n, void *(*next)(void *), void *ctx);
+
+/* Rebuilds the tree in place as a perfectly balanced tree in O(n) (기존 노드를 다시 연결, data 는 그대로)
+	return	1 success
+			0 overflow
+*/
+int BST_Rebalance( TREE *pTree);
+
+/* Builds a read-only search snapshot of the tree (tree is not modified, 읽기 락으로 충분)
+	snapshot 은 dataPtr 만 공유하므로 이후 트리의 삽입/삭제는 반영되지 않음
+	return	snapshot pointer
+			NULL if overflow
+*/
+FROZEN *BST_Freeze( TREE *pTree);
+
+/* Retrieve snapshot for the data containing the requested key (BST_Search 와 같은 결과)
+	비교 결과로 다음 인덱스를 계산하며 내려가고, 마지막에 한 번만 일치 여부를 확인
+	return	address of data containing the key
+			NULL not found
+*/
+void *BST_SearchFrozen( FROZEN *pFrozen, void *keyPtr);
+
+/* Deletes snapshot (data 는 해제하지 않음)
+*/
+void BST_DestroyFrozen( FROZEN *pFrozen);
@@ -0,0 +1,948 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, atoi
+#include <string.h> // strcmp, strdup
+#include <stdint.h> // intptr_t
+#include <time.h>   // clock_gettime
+#include <pthread.h> // pthread_create
+
+#include "bst.h"
+#include "bst_gen.h"
+#include "cbst.h"
+
+// 정렬된 입력에 대한 BST_PLAIN / BST_AVL 비교 벤치마크
+// usage: bst_bench [N [FILE]]
+//	N		정렬된 합성 키 개수 (default 20000)
+//	FILE	단어 파일 (default words.txt, 정렬 후 입력)
+//	이후 무작위 정수 키 1M 개로 malloc / BST_POOL 노드 할당 비교
+// usage: bst_bench -s [N]
+//	정렬된 정수 키 N개 (default 10000000) 스트레스 테스트
+// usage: bst_bench -b [N]
+//	정렬된 정수 키 N개 (default 10000000): BST_Insert 와 BST_BuildFromSorted, 무작위 입력 트리의 BST_Rebalance
+// usage: bst_bench -p [FILE]
+//	FILE 의 단어를 BST_PLAIN / BST_AVL 에 입력, 검색하며 BST_SetPrefix( BST_StringPrefix) 유무 비교
+// usage: bst_bench -g [N [FILE]]
+//	BST_AVL (compare 함수 포인터) 와 DEFINE_BST 로 만든 트리의 insert / search 비교
+//	무작위 정수 키 N개 (default 1000000), FILE 의 단어
+// usage: bst_bench -r [FILE]
+//	FILE 의 어휘에서 "can" 이상 "who" 이하 범위와 무작위 시작점부터 100 단어 범위를
+//	ITER (BST_IterLowerBound + BST_IterNext) 와 BST_Traverse 전체 순회로 읽는 시간 비교
+//	BST_RangeCount, BST_IterSelect 로 20 단어씩 페이지 읽기
+// usage: bst_bench -f [N [FILE]]
+//	BST_Search 와 BST_SearchFrozen 비교: FILE 의 어휘, 무작위 정수 키 N개 (default 10000000)
+// usage: bst_bench -c [N [MS]]
+//	정수 키 N개 (default 1000000) 트리에서 검색 스레드 1/2/4/8 개와 쓰기 스레드 0/1/2 개를 MS ms (default 500) 동안 실행
+//	CBST (락 없는 검색, 노드 단위 쓰기 락) 와 pthread_rwlock 으로 감싼 BST_AVL 의 초당 연산 수 비교
+//	CBST 는 균형을 맞추지 않으므로 키는 무작위 순서로 넣음 (정렬된 키에서는 높이가 N 이 됨)
+
+////////////////////////////////////////////////////////////////////////////////
+static int compare_str( const void *p1, const void *p2)
+{
+	return strcmp( (const char *)p1, (const char *)p2);
+}
+
+static int compare_int( const void *p1, const void *p2)
+{
+	intptr_t k1 = (intptr_t)p1;
+	intptr_t k2 = (intptr_t)p2;
+
+	return (k1 > k2) - (k1 < k2);
+}
+
+static void no_free( void *p)
+{
+	(void)p;
+}
+
+static void no_dup( void *p)
+{
+	(void)p;
+}
+
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int qsort_str( const void *p1, const void *p2)
+{
+	return strcmp( *(char * const *)p1, *(char * const *)p2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// keys[0..n-1] 을 순서대로 삽입한 뒤 전부 검색
+static void run( const char *name, int mode, char **keys, int n)
+{
+	TREE *tree = BST_CreateEx( compare_str, mode);
+	double t0, t1, t2;
+	int i;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, keys[i], no_dup);
+	t1 = now_ms();
+	for (i = 0; i < n; i++)
+		if (BST_Search( tree, keys[i]) == NULL)
+			fprintf( stderr, "missing key : %s\n", keys[i]);
+	t2 = now_ms();
+
+	printf( "%-10s %-6s %9d %9d %7d %12.1f %12.1f\n", name, mode == BST_AVL ? "avl" : "plain",
+		n, BST_Count( tree), BST_Height( tree),
+		(t1 - t0) * 1e6 / n, (t2 - t1) * 1e6 / n);
+
+	BST_Destroy( tree, no_free);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 무작위 키 n개 삽입, 절반 삭제, 다시 삽입(free list 재사용), 해제
+static void alloc_run( int mode, intptr_t *keys, int n)
+{
+	TREE *tree = BST_CreateEx( compare_int, mode);
+	double t0, t1, t2, t3, t4;
+	int i;
+
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, (void *)keys[i], no_dup);
+	t1 = now_ms();
+	for (i = 0; i < n; i += 2)
+		BST_Delete( tree, (void *)keys[i]);
+	t2 = now_ms();
+	for (i = 0; i < n; i += 2)
+		BST_Insert( tree, (void *)keys[i], no_dup);
+	t3 = now_ms();
+	BST_Destroy( tree, no_free);
+	t4 = now_ms();
+
+	printf( "%-10s %9d  insert %7.1f ms  delete %7.1f ms  reinsert %7.1f ms  destroy %6.1f ms\n",
+		mode & BST_POOL ? "avl+pool" : "avl", n, t1 - t0, t2 - t1, t3 - t2, t4 - t3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static long visited;
+
+static void count_visit( const void *p)
+{
+	(void)p;
+	visited++;
+}
+
+// 정렬된 정수 키 n개를 삽입, 검색, 순회, 삭제(절반), 해제
+static int stress( int mode, int n)
+{
+	TREE *tree = BST_CreateEx( compare_int, mode);
+	double t0, t1, t2, t3, t4, t5;
+	intptr_t i;
+
+	t0 = now_ms();
+	for (i = 1; i <= n; i++)
+		if (BST_Insert( tree, (void *)i, no_dup) != 1)
+			return 1;
+	t1 = now_ms();
+	for (i = 1; i <= n; i++)
+		if (BST_Search( tree, (void *)i) != (void *)i)
+			return 1;
+	t2 = now_ms();
+	visited = 0;
+	BST_Traverse( tree, count_visit);
+	BST_TraverseR( tree, count_visit);
+	if (visited != 2L * n)
+		return 1;
+	t3 = now_ms();
+	for (i = 1; i <= n; i += 2)
+		if (BST_Delete( tree, (void *)i) != (void *)i)
+			return 1;
+	t4 = now_ms();
+	printf( "%-6s %9d height %3d  insert %.1f ms  search %.1f ms  traverse x2 %.1f ms  delete %.1f ms",
+		mode == BST_AVL ? "avl" : "plain", n, BST_Height( tree), t1 - t0, t2 - t1, t3 - t2, t4 - t3);
+	BST_Destroy( tree, no_free);
+	t5 = now_ms();
+	printf( "  destroy %.1f ms\n", t5 - t4);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 키 타입과 비교를 고정한 트리 (gen_bench)
+#define INT_CMP( a, b)	(((a) > (b)) - ((a) < (b)))
+
+DEFINE_BST( ITREE, intptr_t, INT_CMP)
+DEFINE_BST( STREE, const char *, strcmp)
+
+static void gen_print( const char *name, const char *kind, int n, double t0, double t1, double t2)
+{
+	printf( "%-10s %-8s %9d  insert %7.1f ns/op  search %7.1f ns/op\n",
+		name, kind, n, (t1 - t0) * 1e6 / n, (t2 - t1) * 1e6 / n);
+}
+
+static int gen_bench( int n, const char *path)
+{
+	intptr_t *ikeys = malloc( sizeof(intptr_t) * n);
+	char **keys;
+	char word[100];
+	FILE *fp;
+	double t0, t1, t2;
+	int i, nwords = 0, cap = 1024, bad = 0;
+
+	for (i = 0; i < n; i++)
+		ikeys[i] = i + 1;
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = ((unsigned)rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+		intptr_t t = ikeys[i];
+		ikeys[i] = ikeys[j];
+		ikeys[j] = t;
+	}
+
+	// 앞선 트리를 해제하면 뒤 트리의 노드가 흩어진 빈 블록에 할당되므로 두 트리를 모두 측정한 뒤 해제
+	{
+		TREE *tree = BST_CreateEx( compare_int, BST_AVL);
+		ITREE_TREE *itree = ITREE_Create();
+
+		t0 = now_ms();
+		for (i = 0; i < n; i++)
+			BST_Insert( tree, (void *)ikeys[i], no_dup);
+		t1 = now_ms();
+		for (i = 0; i < n; i++)
+			bad |= BST_Search( tree, (void *)ikeys[i]) == NULL;
+		t2 = now_ms();
+		gen_print( "random-int", "generic", n, t0, t1, t2);
+
+		t0 = now_ms();
+		for (i = 0; i < n; i++)
+			ITREE_Insert( itree, ikeys[i]);
+		t1 = now_ms();
+		for (i = 0; i < n; i++)
+			bad |= ITREE_Search( itree, ikeys[i]) == NULL;
+		t2 = now_ms();
+		gen_print( "random-int", "DEFINE", n, t0, t1, t2);
+
+		BST_Destroy( tree, no_free);
+		ITREE_Destroy( itree);
+	}
+	free( ikeys);
+
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	keys = malloc( sizeof(char *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (nwords == cap)
+			keys = realloc( keys, sizeof(char *) * (cap *= 2));
+		keys[nwords++] = strdup( word);
+	}
+	fclose( fp);
+
+	{
+		TREE *tree = BST_CreateEx( compare_str, BST_AVL);
+		STREE_TREE *stree = STREE_Create();
+
+		t0 = now_ms();
+		for (i = 0; i < nwords; i++)
+			BST_Insert( tree, keys[i], no_dup);
+		t1 = now_ms();
+		for (i = 0; i < nwords; i++)
+			bad |= BST_Search( tree, keys[i]) == NULL;
+		t2 = now_ms();
+		gen_print( "words", "generic", nwords, t0, t1, t2);
+
+		t0 = now_ms();
+		for (i = 0; i < nwords; i++)
+			STREE_Insert( stree, keys[i]);
+		t1 = now_ms();
+		for (i = 0; i < nwords; i++)
+			bad |= STREE_Search( stree, keys[i]) == NULL;
+		t2 = now_ms();
+		gen_print( "words", "DEFINE", nwords, t0, t1, t2);
+
+		BST_Destroy( tree, no_free);
+		STREE_Destroy( stree);
+	}
+
+	for (i = 0; i < nwords; i++)
+		free( keys[i]);
+	free( keys);
+	return bad;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// compare 호출 횟수를 셈 (prefix_run)
+static long compared;
+
+static int count_str( const void *p1, const void *p2)
+{
+	compared++;
+	return strcmp( (const char *)p1, (const char *)p2);
+}
+
+// keys[0..n-1] (중복 포함) 을 입력한 뒤 전부 검색
+static void prefix_run( int mode, int prefix, char **keys, int n)
+{
+	TREE *tree = BST_CreateEx( count_str, mode);
+	double t0, t1, t2;
+	long c0, c1;
+	int i;
+
+	if (prefix)
+		BST_SetPrefix( tree, BST_StringPrefix);
+
+	compared = 0;
+	t0 = now_ms();
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, keys[i], no_dup);
+	t1 = now_ms();
+	c0 = compared;
+	for (i = 0; i < n; i++)
+		BST_Search( tree, keys[i]);
+	t2 = now_ms();
+	c1 = compared - c0;
+
+	printf( "%-6s %-4s %9d  insert %7.1f ns/op %6.2f cmp/op  search %7.1f ns/op %6.2f cmp/op\n",
+		mode == BST_AVL ? "avl" : "plain", prefix ? "on" : "off", n,
+		(t1 - t0) * 1e6 / n, (double)c0 / n, (t2 - t1) * 1e6 / n, (double)c1 / n);
+	BST_Destroy( tree, no_free);
+}
+
+static int prefix_bench( const char *path)
+{
+	char **keys;
+	char word[100];
+	FILE *fp;
+	int i, nwords = 0, cap = 1024;
+
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	keys = malloc( sizeof(char *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (nwords == cap)
+			keys = realloc( keys, sizeof(char *) * (cap *= 2));
+		keys[nwords++] = strdup( word);
+	}
+	fclose( fp);
+
+	prefix_run( BST_PLAIN, 0, keys, nwords);
+	prefix_run( BST_PLAIN, 1, keys, nwords);
+	prefix_run( BST_AVL, 0, keys, nwords);
+	prefix_run( BST_AVL, 1, keys, nwords);
+
+	for (i = 0; i < nwords; i++)
+		free( keys[i]);
+	free( keys);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 정렬된 키로 트리 만들기: 하나씩 BST_Insert (AVL) / BST_BuildFromSorted
+// 무작위 순서로 만든 일반 트리를 BST_Rebalance
+static int bulk_bench( int n)
+{
+	void **keys = malloc( sizeof(void *) * n);
+	TREE *tree;
+	double t0, t1, t2, t3;
+	int i, height;
+
+	for (i = 0; i < n; i++)
+		keys[i] = (void *)(intptr_t)(i + 1);
+
+	t0 = now_ms();
+	tree = BST_CreateEx( compare_int, BST_AVL | BST_POOL);
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, keys[i], no_dup);
+	t1 = now_ms();
+	height = BST_Height( tree);
+	BST_Destroy( tree, no_free);
+
+	t2 = now_ms();
+	tree = BST_BuildFromSorted( compare_int, BST_AVL, keys, n);
+	t3 = now_ms();
+	if (tree == NULL)
+		return 1;
+	printf( "%-10s %9d  insert %8.1f ms (height %2d)  build %8.1f ms (height %2d)\n",
+		"sorted", n, t1 - t0, height, t3 - t2, BST_Height( tree));
+	for (i = 0; i < n; i++)
+		if (BST_Search( tree, keys[i]) != keys[i])
+			return 1;
+	BST_Destroy( tree, no_free);
+
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = ((unsigned)rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+		void *t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+	tree = BST_CreateEx( compare_int, BST_PLAIN | BST_POOL);
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, keys[i], no_dup);
+	height = BST_Height( tree);
+	t0 = now_ms();
+	if (!BST_Rebalance( tree))
+		return 1;
+	t1 = now_ms();
+	printf( "%-10s %9d  rebalance %8.1f ms (height %2d -> %2d)\n",
+		"random", n, t1 - t0, height, BST_Height( tree));
+	BST_Destroy( tree, no_free);
+
+	free( keys);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BST_Traverse 로 [rangeLo, rangeHi] 범위의 단어를 셈 (range_bench 의 비교 대상)
+static const char *rangeLo, *rangeHi;
+static long inRange;
+
+static void count_range( const void *p)
+{
+	if (strcmp( p, rangeLo) >= 0 && strcmp( p, rangeHi) <= 0)
+		inRange++;
+}
+
+// 반복자로 [lo, hi] 범위의 단어를 셈
+static long iter_range( ITER *it, const char *lo, const char *hi)
+{
+	const char *p;
+	long count = 0;
+
+	BST_IterLowerBound( it, (void *)lo);
+	while ((p = BST_IterNext( it)) != NULL && strcmp( p, hi) <= 0)
+		count++;
+	return count;
+}
+
+static int range_bench( const char *path)
+{
+	TREE *tree = BST_CreateEx( compare_str, BST_AVL | BST_POOL);
+	ITER *it;
+	char **vocab;
+	char word[100];
+	FILE *fp;
+	double t0, t1, t2;
+	long count = 0, span;
+	int i, r, rounds = 1000, nvocab = 0;
+
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		char *s = strdup( word);
+
+		if (BST_Insert( tree, s, no_dup) != 1)
+			free( s);
+	}
+	fclose( fp);
+
+	// 정렬된 어휘 (무작위 범위의 양 끝을 고르기 위해)
+	vocab = malloc( sizeof(char *) * (BST_Count( tree) + 1));
+	it = BST_IterCreate( tree, BST_FORWARD);
+	while ((vocab[nvocab] = BST_IterNext( it)) != NULL)
+		nvocab++;
+	if (nvocab < 100)
+		rounds = 0;
+
+	t0 = now_ms();
+	count = iter_range( it, "can", "who");
+	t1 = now_ms();
+	rangeLo = "can";
+	rangeHi = "who";
+	inRange = 0;
+	BST_Traverse( tree, count_range);
+	t2 = now_ms();
+	printf( "%-10s %9d  [can, who] %7ld words  iter %8.3f ms  traverse %8.3f ms\n",
+		"words", nvocab, count, t1 - t0, t2 - t1);
+	if (count != inRange)
+		return 1;
+	span = count;
+
+	srand( 1);
+	count = inRange = 0;
+	t0 = now_ms();
+	for (r = 0; r < rounds; r++)
+	{
+		i = rand() % (nvocab - 99);
+		count += iter_range( it, vocab[i], vocab[i + 99]);
+	}
+	t1 = now_ms();
+	srand( 1);
+	for (r = 0; r < rounds; r++)
+	{
+		i = rand() % (nvocab - 99);
+		rangeLo = vocab[i];
+		rangeHi = vocab[i + 99];
+		BST_Traverse( tree, count_range);
+	}
+	t2 = now_ms();
+	printf( "%-10s %9d  %d x 100 words  iter %8.3f ms/query  traverse %8.3f ms/query\n",
+		"words", nvocab, rounds, (t1 - t0) / rounds, (t2 - t1) / rounds);
+	if (count != inRange || count != 100L * rounds)
+		return 1;
+
+	// BST_RangeCount 와 BST_IterSelect 로 20 단어 페이지 읽기 (전체 순회 없이 O(log n))
+	t0 = now_ms();
+	count = BST_RangeCount( tree, "can", "who");
+	t1 = now_ms();
+	printf( "%-10s %9d  [can, who] %7ld words  BST_RangeCount %8.4f ms\n", "words", nvocab, count, t1 - t0);
+	if (count != span)
+		return 1;
+
+	srand( 1);
+	t0 = now_ms();
+	for (r = 0; r < rounds; r++)
+	{
+		i = rand() % (nvocab / 20) * 20;
+		BST_IterSelect( it, i);
+		for (count = 0; count < 20; count++)
+			if (BST_IterNext( it) != vocab[i + count])
+				return 1;
+		if (BST_Rank( tree, vocab[i]) != i || BST_Select( tree, i) != vocab[i])
+			return 1;
+	}
+	t1 = now_ms();
+	printf( "%-10s %9d  %d x page of 20  BST_IterSelect %8.4f ms/page\n", "words", nvocab, rounds, (t1 - t0) / rounds);
+
+	BST_IterDestroy( it);
+	free( vocab);
+	BST_Destroy( tree, free);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 트리와 스냅샷에서 keys[0..n-1] 을 rounds 번 검색
+static int freeze_run( const char *name, TREE *tree, void **keys, int n, int rounds)
+{
+	FROZEN *frozen;
+	double t0, t1, t2, t3;
+	int i, r;
+
+	t0 = now_ms();
+	frozen = BST_Freeze( tree);
+	t1 = now_ms();
+	if (frozen == NULL)
+		return 1;
+
+	for (r = 0; r < rounds; r++)
+		for (i = 0; i < n; i++)
+			if (BST_Search( tree, keys[i]) != keys[i])
+				return 1;
+	t2 = now_ms();
+	for (r = 0; r < rounds; r++)
+		for (i = 0; i < n; i++)
+			if (BST_SearchFrozen( frozen, keys[i]) != keys[i])
+				return 1;
+	t3 = now_ms();
+
+	printf( "%-10s %9d %9d  freeze %7.1f ms  search %7.1f ns/op  frozen %7.1f ns/op  (x%.2f)\n",
+		name, BST_Count( tree), n, t1 - t0, (t2 - t1) * 1e6 / ((double)n * rounds),
+		(t3 - t2) * 1e6 / ((double)n * rounds), (t2 - t1) / (t3 - t2));
+	BST_DestroyFrozen( frozen);
+	return 0;
+}
+
+static int freeze_bench( int n, const char *path)
+{
+	TREE *tree;
+	void **keys;
+	char word[100];
+	FILE *fp;
+	int i, nwords = 0, cap = 1024;
+
+	// words.txt 의 어휘 (검색 키는 트리에 저장된 포인터 그대로, 등장 순서대로)
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	tree = BST_CreateEx( compare_str, BST_AVL | BST_POOL);
+	keys = malloc( sizeof(void *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		char *s = strdup( word);
+
+		if (BST_Insert( tree, s, no_dup) != 1)
+		{
+			free( s);
+			s = BST_Search( tree, word);
+		}
+		if (nwords == cap)
+			keys = realloc( keys, sizeof(void *) * (cap *= 2));
+		keys[nwords++] = s;
+	}
+	fclose( fp);
+	if (freeze_run( "words", tree, keys, nwords, 20))
+		return 1;
+	BST_Destroy( tree, free);
+	free( keys);
+
+	// 무작위 순서의 서로 다른 정수 키
+	tree = BST_CreateEx( compare_int, BST_AVL | BST_POOL);
+	keys = malloc( sizeof(void *) * n);
+	for (i = 0; i < n; i++)
+		keys[i] = (void *)(intptr_t)(i + 1);
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = ((unsigned)rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+		void *t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+	for (i = 0; i < n; i++)
+		BST_Insert( tree, keys[i], no_dup);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = ((unsigned)rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+		void *t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+	if (freeze_run( "random-int", tree, keys, n, 1))
+		return 1;
+	BST_Destroy( tree, no_free);
+	free( keys);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 동시 읽기/쓰기 벤치마크 (-c)
+// readers 개 스레드는 검색만, writers 개 스레드는 삭제와 삽입을 번갈아 (트리 크기 유지)
+// CTREE (락 없는 검색) 와 pthread_rwlock 으로 감싼 TREE (BST_AVL) 비교
+typedef struct
+{
+	int					kind;	// 0 CTREE, 1 TREE + rwlock
+	int					writer;	// 1 if 쓰기 스레드
+	int					space;	// 키 범위 [1, space]
+	unsigned long long	rng;
+	long				ops;
+} WORKER;
+
+static CTREE *ctree;
+static TREE *rwtree;
+static pthread_rwlock_t rwlock = PTHREAD_RWLOCK_INITIALIZER;
+static atomic_int stopFlag;
+
+static unsigned long long xorshift( unsigned long long *s)
+{
+	*s ^= *s << 13;
+	*s ^= *s >> 7;
+	*s ^= *s << 17;
+	return *s;
+}
+
+static void *worker_main( void *arg)
+{
+	WORKER *w = arg;
+	CTHREAD *t = w -> kind == 0 ? CBST_Attach( ctree) : NULL;
+	long ops = 0;
+
+	while (!atomic_load_explicit( &stopFlag, memory_order_relaxed))
+	{
+		void *key = (void *)(intptr_t)(xorshift( &w -> rng) % w -> space + 1);
+
+		if (!w -> writer)
+		{
+			if (w -> kind == 0)
+				CBST_Search( t, key, NULL);
+			else
+			{
+				pthread_rwlock_rdlock( &rwlock);
+				BST_Search( rwtree, key);
+				pthread_rwlock_unlock( &rwlock);
+			}
+		}
+		else if (w -> kind == 0)
+		{
+			if (ops % 2 == 0)
+				CBST_Delete( t, key);
+			else
+				CBST_Insert( t, key);
+		}
+		else
+		{
+			pthread_rwlock_wrlock( &rwlock);
+			if (ops % 2 == 0)
+				BST_Delete( rwtree, key);
+			else
+				BST_Insert( rwtree, key, no_dup);
+			pthread_rwlock_unlock( &rwlock);
+		}
+		ops++;
+	}
+	if (t != NULL)
+		CBST_Detach( t);
+	w -> ops = ops;
+	return NULL;
+}
+
+static intptr_t lastKey;
+static long ordered;
+
+static void check_order( const void *p)
+{
+	if ((intptr_t)p > lastKey)
+		ordered++;
+	lastKey = (intptr_t)p;
+}
+
+// readers + writers 개 스레드를 ms 동안 돌리고 초당 연산 수 출력
+// return	0 if successful
+//			1 if CTREE 순서나 개수가 맞지 않음
+static int concurrent_run( int kind, int readers, int writers, intptr_t *keys, int n, int ms)
+{
+	pthread_t tid[64];
+	WORKER w[64];
+	struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+	long reads = 0, writes = 0;
+	double t0, t1;
+	int i, count;
+
+	if (kind == 0)
+	{
+		CTHREAD *t;
+
+		ctree = CBST_Create( compare_int, NULL);
+		t = CBST_Attach( ctree);
+		for (i = 0; i < n; i++)
+			CBST_Insert( t, (void *)keys[i]);
+		CBST_Detach( t);
+	}
+	else
+	{
+		rwtree = BST_CreateEx( compare_int, BST_AVL | BST_POOL);
+		for (i = 0; i < n; i++)
+			BST_Insert( rwtree, (void *)keys[i], no_dup);
+	}
+
+	atomic_store( &stopFlag, 0);
+	for (i = 0; i < readers + writers; i++)
+	{
+		w[i].kind = kind;
+		w[i].writer = i >= readers;
+		w[i].space = 2 * n;
+		w[i].rng = 88172645463325252ULL + 7919ULL * (i + 1);
+		w[i].ops = 0;
+	}
+	t0 = now_ms();
+	for (i = 0; i < readers + writers; i++)
+		pthread_create( &tid[i], NULL, worker_main, &w[i]);
+	nanosleep( &ts, NULL);
+	atomic_store( &stopFlag, 1);
+	for (i = 0; i < readers + writers; i++)
+	{
+		pthread_join( tid[i], NULL);
+		if (w[i].writer)
+			writes += w[i].ops;
+		else
+			reads += w[i].ops;
+	}
+	t1 = now_ms();
+
+	printf( "%-8s %7d %7d %14.2f %14.2f %14.2f\n", kind == 0 ? "cbst" : "rwlock", readers, writers,
+		reads / (t1 - t0) / 1000.0, readers > 0 ? reads / (t1 - t0) / 1000.0 / readers : 0.0,
+		writes / (t1 - t0) / 1000.0);
+
+	if (kind == 1)
+	{
+		BST_Destroy( rwtree, no_free);
+		return 0;
+	}
+
+	// 중위 순회가 strictly ascending 이고 개수가 CBST_Count 와 같은지 확인
+	{
+		CTHREAD *t = CBST_Attach( ctree);
+
+		lastKey = 0;
+		ordered = 0;
+		CBST_Traverse( t, check_order);
+		CBST_Detach( t);
+		count = CBST_Count( ctree);
+		CBST_Destroy( ctree, NULL);
+	}
+	return ordered != count;
+}
+
+static int concurrent_bench( int n, int ms)
+{
+	int readers[] = { 1, 2, 4, 8 };
+	intptr_t *keys = malloc( sizeof(intptr_t) * n);
+	int i, k, r, writers;
+
+	// 키 범위 [1, 2n] 에서 무작위 순서의 홀수 키 n개 (검색의 절반은 실패)
+	// CBST 는 균형을 맞추지 않으므로 무작위 순서가 필요 (정렬된 순서로 넣으면 모든 연산이 O(n))
+	for (i = 0; i < n; i++)
+		keys[i] = 2 * i + 1;
+	srand( 1);
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = ((unsigned)rand() * (RAND_MAX + 1u) + rand()) % (i + 1);
+		intptr_t t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+
+	printf( "%-8s %7s %7s %14s %14s %14s\n", "tree", "readers", "writers", "Mreads/s", "Mreads/s/thr", "Mwrites/s");
+	for (writers = 0; writers <= 2; writers++)
+		for (k = 0; k < 2; k++)
+			for (r = 0; r < 4; r++)
+				if (concurrent_run( k, readers[r], writers, keys, n, ms))
+				{
+					free( keys);
+					return 1;
+				}
+	free( keys);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int n;
+	const char *path;
+	char **keys;
+	char word[100];
+	FILE *fp;
+	int i, nwords = 0, cap = 1024;
+
+	if (argc > 1 && strcmp( argv[1], "-s") == 0)
+	{
+		n = argc > 2 ? atoi( argv[2]) : 10000000;
+
+		// BST_PLAIN 은 정렬 입력에서 O(n^2) 이므로 깊이 n/500 의 일직선 트리만 확인
+		if (stress( BST_AVL, n) || stress( BST_PLAIN, n / 500))
+		{
+			fprintf( stderr, "stress test failed\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && strcmp( argv[1], "-b") == 0)
+	{
+		if (bulk_bench( argc > 2 ? atoi( argv[2]) : 10000000))
+		{
+			fprintf( stderr, "bulk build failed\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && strcmp( argv[1], "-g") == 0)
+	{
+		if (gen_bench( argc > 2 ? atoi( argv[2]) : 1000000, argc > 3 ? argv[3] : "words.txt"))
+		{
+			fprintf( stderr, "search failed\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && strcmp( argv[1], "-p") == 0)
+		return prefix_bench( argc > 2 ? argv[2] : "words.txt");
+
+	if (argc > 1 && strcmp( argv[1], "-r") == 0)
+	{
+		if (range_bench( argc > 2 ? argv[2] : "words.txt"))
+		{
+			fprintf( stderr, "range count mismatch\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && strcmp( argv[1], "-f") == 0)
+	{
+		if (freeze_bench( argc > 2 ? atoi( argv[2]) : 10000000, argc > 3 ? argv[3] : "words.txt"))
+		{
+			fprintf( stderr, "freeze search mismatch\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 1 && strcmp( argv[1], "-c") == 0)
+	{
+		if (concurrent_bench( argc > 2 ? atoi( argv[2]) : 1000000, argc > 3 ? atoi( argv[3]) : 500))
+		{
+			fprintf( stderr, "concurrent tree order mismatch\n");
+			return 1;
+		}
+		return 0;
+	}
+
+	n = argc > 1 ? atoi( argv[1]) : 20000;
+	path = argc > 2 ? argv[2] : "words.txt";
+
+	printf( "%-10s %-6s %9s %9s %7s %12s %12s\n", "input", "mode", "ops", "count", "height", "insert ns/op", "search ns/op");
+
+	// 정렬된 합성 키
+	keys = malloc( sizeof(char *) * n);
+	for (i = 0; i < n; i++)
+	{
+		sprintf( word, "k%09d", i);
+		keys[i] = strdup( word);
+	}
+	run( "sorted", BST_PLAIN, keys, n);
+	run( "sorted", BST_AVL, keys, n);
+	for (i = 0; i < n; i++)
+		free( keys[i]);
+	free( keys);
+
+	// 정렬된 words.txt (중복 포함)
+	if ((fp = fopen( path, "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	keys = malloc( sizeof(char *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (nwords == cap)
+			keys = realloc( keys, sizeof(char *) * (cap *= 2));
+		keys[nwords++] = strdup( word);
+	}
+	fclose( fp);
+
+	run( "words", BST_PLAIN, keys, nwords);
+	run( "words", BST_AVL, keys, nwords);
+	qsort( keys, nwords, sizeof(char *), qsort_str);
+	run( "words-sort", BST_PLAIN, keys, nwords);
+	run( "words-sort", BST_AVL, keys, nwords);
+
+	for (i = 0; i < nwords; i++)
+		free( keys[i]);
+	free( keys);
+
+	// 노드 할당 방식 비교 (무작위 순서의 서로 다른 정수 키)
+	{
+		int m = 1000000;
+		intptr_t *ikeys = malloc( sizeof(intptr_t) * m);
+
+		for (i = 0; i < m; i++)
+			ikeys[i] = i;
+		srand( 1);
+		for (i = m - 1; i > 0; i--)
+		{
+			int j = rand() % (i + 1);
+			intptr_t t = ikeys[i];
+			ikeys[i] = ikeys[j];
+			ikeys[j] = t;
+		}
+		printf( "\n");
+		alloc_run( BST_AVL, ikeys, m);
+		alloc_run( BST_AVL | BST_POOL, ikeys, m);
+		free( ikeys);
+	}
+
+	return 0;
+}
@@ -0,0 +1,269 @@
+#ifndef BST_GEN_H
+#define BST_GEN_H
+
+#include <stdlib.h> // malloc, realloc
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINE_BST( name, T, cmp)
+// 키 타입 T 와 비교 cmp 를 컴파일 시점에 고정한 AVL 트리를 만듦
+// 노드에 void * 대신 T 를 직접 저장하고 cmp 를 함수 포인터 없이 호출하므로 비교가 인라인됨
+//	T			키 타입 (int, intptr_t, const char * 등, 대입으로 복사)
+//	cmp( a, b)	T 두 개를 받아 a < b 이면 음수, 같으면 0, a > b 이면 양수 (함수 또는 매크로)
+//
+// 만들어지는 타입과 함수 (name 이 접두사, 반환값 규약은 bst.h 와 같음)
+//	name_NODE, name_TREE
+//	name_Create, name_Destroy, name_Insert, name_Delete, name_Search, name_Count, name_Traverse
+//
+// bst.h 의 void * / compare 함수 포인터 API 는 그대로 일반(generic) 버전으로 사용
+// 예)	#define INT_CMP( a, b)	(((a) > (b)) - ((a) < (b)))
+//		DEFINE_BST( ITREE, int, INT_CMP)
+//		ITREE_TREE *tree = ITREE_Create();
+
+// AVL 트리 높이 상한 (경로 스택 크기)
+#define BST_GEN_MAX_HEIGHT	64
+
+#define DEFINE_BST( name, T, cmp) \
+\
+typedef struct name##_node \
+{ \
+	T					key; \
+	struct name##_node	*left; \
+	struct name##_node	*right; \
+	int					height; \
+} name##_NODE; \
+\
+typedef struct \
+{ \
+	int			count; \
+	name##_NODE	*root; \
+} name##_TREE; \
+\
+/* AVL helpers */ \
+static inline int name##_height( name##_NODE *root){ \
+	return root == NULL ? 0 : root -> height; \
+} \
+\
+static inline void name##_updateHeight( name##_NODE *root){ \
+	int lh = name##_height(root -> left); \
+	int rh = name##_height(root -> right); \
+\
+	root -> height = (lh > rh ? lh : rh) + 1; \
+} \
+\
+static inline name##_NODE *name##_rotateRight( name##_NODE *root){ \
+	name##_NODE *newRoot = root -> left; \
+\
+	root -> left = newRoot -> right; \
+	newRoot -> right = root; \
+	name##_updateHeight(root); \
+	name##_updateHeight(newRoot); \
+	return newRoot; \
+} \
+\
+static inline name##_NODE *name##_rotateLeft( name##_NODE *root){ \
+	name##_NODE *newRoot = root -> right; \
+\
+	root -> right = newRoot -> left; \
+	newRoot -> left = root; \
+	name##_updateHeight(root); \
+	name##_updateHeight(newRoot); \
+	return newRoot; \
+} \
+\
+static inline name##_NODE *name##_balance( name##_NODE *root){ \
+	name##_updateHeight(root); \
+\
+	int bf = name##_height(root -> left) - name##_height(root -> right); \
+\
+	if(bf > 1){ \
+		if(name##_height(root -> left -> left) < name##_height(root -> left -> right)){ \
+			root -> left = name##_rotateLeft(root -> left); \
+		} \
+		return name##_rotateRight(root); \
+	} \
+	if(bf < -1){ \
+		if(name##_height(root -> right -> right) < name##_height(root -> right -> left)){ \
+			root -> right = name##_rotateRight(root -> right); \
+		} \
+		return name##_rotateLeft(root); \
+	} \
+	return root; \
+} \
+\
+/* Allocates dynamic memory for a tree head node \
+	return	head node pointer \
+			NULL if overflow \
+*/ \
+static inline name##_TREE *name##_Create( void){ \
+	name##_TREE *pTree = malloc(sizeof(name##_TREE)); \
+	if(pTree == NULL) return NULL; \
+\
+	pTree -> count = 0; \
+	pTree -> root = NULL; \
+	return pTree; \
+} \
+\
+/* Deletes all nodes and the head node (회전으로 왼쪽 서브트리를 없애며 해제, 추가 메모리 없음) \
+*/ \
+static inline void name##_Destroy( name##_TREE *pTree){ \
+	name##_NODE *cur = pTree -> root; \
+\
+	while(cur != NULL){ \
+		if(cur -> left != NULL){ \
+			name##_NODE *left = cur -> left; \
+			cur -> left = left -> right; \
+			left -> right = cur; \
+			cur = left; \
+		} \
+		else{ \
+			name##_NODE *next = cur -> right; \
+			free(cur); \
+			cur = next; \
+		} \
+	} \
+	free(pTree); \
+} \
+\
+/* Inserts new key into the tree \
+	return	0 overflow \
+			1 success \
+			2 if duplicated key \
+*/ \
+static inline int name##_Insert( name##_TREE *pTree, T key){ \
+	name##_NODE **path[BST_GEN_MAX_HEIGHT]; \
+	int top = 0; \
+	name##_NODE **link = &pTree -> root; \
+\
+	while(*link != NULL){ \
+		int c = cmp(key, (*link) -> key); \
+\
+		if(c == 0) return 2; \
+		path[top++] = link; \
+		link = c < 0 ? &(*link) -> left : &(*link) -> right; \
+	} \
+\
+	name##_NODE *newnode = malloc(sizeof(name##_NODE)); \
+	if(newnode == NULL) return 0; \
+\
+	newnode -> key = key; \
+	newnode -> left = NULL; \
+	newnode -> right = NULL; \
+	newnode -> height = 1; \
+	*link = newnode; \
+	pTree -> count++; \
+\
+	while(top > 0){ \
+		link = path[--top]; \
+\
+		int oldHeight = (*link) -> height; \
+		*link = name##_balance(*link); \
+		if((*link) -> height == oldHeight) break; \
+	} \
+	return 1; \
+} \
+\
+/* Deletes a node with key from the tree \
+	keyOut	삭제된 노드의 키 (NULL 이면 저장하지 않음) \
+	return	1 deleted \
+			0 not found \
+*/ \
+static inline int name##_Delete( name##_TREE *pTree, T key, T *keyOut){ \
+	name##_NODE **path[BST_GEN_MAX_HEIGHT]; \
+	int top = 0; \
+	name##_NODE **link = &pTree -> root; \
+\
+	while(*link != NULL){ \
+		int c = cmp(key, (*link) -> key); \
+\
+		if(c == 0) break; \
+		path[top++] = link; \
+		link = c < 0 ? &(*link) -> left : &(*link) -> right; \
+	} \
+	if(*link == NULL) return 0; \
+\
+	name##_NODE *target = *link; \
+	if(keyOut != NULL) *keyOut = target -> key; \
+\
+	if(target -> left != NULL && target -> right != NULL){ \
+		/* 후속자(오른쪽 서브트리의 최소값)를 이 노드로 옮기고 후속자 노드를 제거 */ \
+		path[top++] = link; \
+\
+		name##_NODE **minLink = &target -> right; \
+		while((*minLink) -> left != NULL){ \
+			path[top++] = minLink; \
+			minLink = &(*minLink) -> left; \
+		} \
+		name##_NODE *minright = *minLink; \
+		target -> key = minright -> key; \
+		*minLink = minright -> right; \
+		free(minright); \
+	} \
+	else{ \
+		*link = target -> left != NULL ? target -> left : target -> right; \
+		free(target); \
+	} \
+	pTree -> count--; \
+\
+	while(top > 0){ \
+		link = path[--top]; \
+		*link = name##_balance(*link); \
+	} \
+	return 1; \
+} \
+\
+/* Retrieve tree for the node containing the requested key \
+	return	address of key stored in the node \
+			NULL not found \
+*/ \
+static inline T *name##_Search( name##_TREE *pTree, T key){ \
+	name##_NODE *cur = pTree -> root; \
+\
+	while(cur != NULL){ \
+		int c = cmp(key, cur -> key); \
+\
+		if(c == 0) return &cur -> key; \
+		cur = c < 0 ? cur -> left : cur -> right; \
+	} \
+	return NULL; \
+} \
+\
+/* returns number of nodes in tree \
+*/ \
+static inline int name##_Count( name##_TREE *pTree){ \
+	return pTree -> count; \
+} \
+\
+/* traverses keys in order \
+	bst.c 의 _traverse 와 같은 명시적 스택 (트리의 링크를 바꾸지 않으므로 callback 에서 Search 해도 됨) \
+	스택은 힙에 두고 차면 두 배로 늘림, 늘리지 못하면 거기서 멈춤 \
+*/ \
+static inline void name##_Traverse( name##_TREE *pTree, void (*callback)(T)){ \
+	int capacity = BST_GEN_MAX_HEIGHT; \
+	int top = 0; \
+	name##_NODE **stack = malloc(sizeof(name##_NODE *) * capacity); \
+	name##_NODE *cur = pTree -> root; \
+\
+	if(stack == NULL) return; \
+\
+	while(cur != NULL || top > 0){ \
+		while(cur != NULL){ \
+			if(top == capacity){ \
+				name##_NODE **newStack = realloc(stack, sizeof(name##_NODE *) * capacity * 2); \
+				if(newStack == NULL){ \
+					free(stack); \
+					return; \
+				} \
+				stack = newStack; \
+				capacity *= 2; \
+			} \
+			stack[top++] = cur; \
+			cur = cur -> left; \
+		} \
+		cur = stack[--top]; \
+		callback(cur -> key); \
+		cur = cur -> right; \
+	} \
+	free(stack); \
+}
+
+#endif
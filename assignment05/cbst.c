@@ -0,0 +1,427 @@
+#include <stdlib.h> // malloc
+
+#include "cbst.h"
+
+// internal function declarations
+static CNODE *_makeNode( void *dataInPtr);
+static void _freeNode( CTREE *pTree, CNODE *node);
+static void _freeList( CTREE *pTree, CNODE *node);
+static int _find( CTREE *pTree, void *keyPtr, CNODE **pPre, CNODE **pLoc, int *pDir);
+static void _enter( CTHREAD *pThread);
+static void _leave( CTHREAD *pThread);
+static void _retire( CTHREAD *pThread, CNODE *node);
+static void _advance( CTREE *pTree);
+static void _traverse( CNODE *root, void (*callback)(const void *));
+
+// 해제 대기 노드를 이만큼 모을 때마다 전역 epoch 진행을 시도
+#define CBST_RETIRE_BATCH	64
+
+// dir 쪽 자식 링크 (0 left, 1 right)
+static inline _Atomic(CNODE *) *_child( CNODE *node, int dir){
+	return dir ? &node -> right : &node -> left;
+}
+
+/* Allocates dynamic memory for a concurrent tree head node
+	return	head node pointer
+			NULL if overflow
+*/
+CTREE *CBST_Create( int (*compare)(const void *, const void *), void (*freeData)(void *)){
+	CTREE *pTree = aligned_alloc(64, sizeof(CTREE));
+	if(pTree == NULL) return NULL;
+
+	pTree -> head.dataPtr = NULL;
+	atomic_init(&pTree -> head.left, NULL);
+	atomic_init(&pTree -> head.right, NULL);
+	atomic_init(&pTree -> head.marked, 0);
+	pTree -> head.ownsData = 0;
+	pTree -> head.limbo = NULL;
+	pthread_mutex_init(&pTree -> head.lock, NULL);
+
+	atomic_init(&pTree -> count, 0);
+	pTree -> compare = compare;
+	pTree -> freeData = freeData;
+	atomic_init(&pTree -> epoch, 0);
+
+	for(int i = 0; i < CBST_MAX_THREADS; i++){
+		CTHREAD *t = &pTree -> threads[i];
+
+		atomic_init(&t -> epoch, 0);
+		atomic_init(&t -> used, 0);
+		t -> seen = 0;
+		t -> limbo[0] = t -> limbo[1] = t -> limbo[2] = NULL;
+		t -> retired = 0;
+		t -> tree = pTree;
+	}
+	return pTree;
+}
+
+/* Deletes all nodes, pending nodes and the head node
+	트리에 남은 노드는 회전으로 왼쪽 서브트리를 없애며 해제 (추가 메모리 없음)
+*/
+void CBST_Destroy( CTREE *pTree, void (*callback)(void *)){
+	CNODE *cur = atomic_load(&pTree -> head.left);
+
+	while(cur != NULL){
+		CNODE *left = atomic_load_explicit(&cur -> left, memory_order_relaxed);
+
+		if(left != NULL){
+			atomic_store_explicit(&cur -> left, atomic_load_explicit(&left -> right, memory_order_relaxed), memory_order_relaxed);
+			atomic_store_explicit(&left -> right, cur, memory_order_relaxed);
+			cur = left;
+		}
+		else{
+			CNODE *next = atomic_load_explicit(&cur -> right, memory_order_relaxed);
+
+			if(callback != NULL) callback(cur -> dataPtr);
+			cur -> ownsData = 0;
+			_freeNode(pTree, cur);
+			cur = next;
+		}
+	}
+
+	for(int i = 0; i < CBST_MAX_THREADS; i++){
+		for(int j = 0; j < 3; j++){
+			_freeList(pTree, pTree -> threads[i].limbo[j]);
+		}
+	}
+	pthread_mutex_destroy(&pTree -> head.lock);
+	free(pTree);
+}
+
+/* Registers the calling thread
+	return	thread handle
+			NULL if CBST_MAX_THREADS 개가 모두 사용 중
+*/
+CTHREAD *CBST_Attach( CTREE *pTree){
+	for(int i = 0; i < CBST_MAX_THREADS; i++){
+		int expected = 0;
+
+		if(atomic_compare_exchange_strong(&pTree -> threads[i].used, &expected, 1)){
+			return &pTree -> threads[i];
+		}
+	}
+	return NULL;
+}
+
+/* Unregisters the thread
+*/
+void CBST_Detach( CTHREAD *pThread){
+	atomic_store(&pThread -> used, 0);
+}
+
+/* Inserts new data into the tree
+	검색으로 찾은 빈 자리의 부모만 잠그고, 부모가 떼어지지 않았고 자리가 아직 비어 있으면 연결
+	return	0 overflow
+			1 success
+			2 if duplicated key
+*/
+int CBST_Insert( CTHREAD *pThread, void *dataInPtr){
+	CTREE *pTree = pThread -> tree;
+	CNODE *newPtr = _makeNode(dataInPtr);
+	CNODE *pPre, *pLoc;
+	int dir;
+
+	if(newPtr == NULL) return 0;
+
+	_enter(pThread);
+	while(1){
+		int found = _find(pTree, dataInPtr, &pPre, &pLoc, &dir);
+
+		if(found){
+			_leave(pThread);
+			_freeNode(pTree, newPtr);
+			return 2;
+		}
+
+		pthread_mutex_lock(&pPre -> lock);
+		if(!atomic_load(&pPre -> marked) && atomic_load(_child(pPre, dir)) == NULL){
+			atomic_store_explicit(_child(pPre, dir), newPtr, memory_order_release);
+			pthread_mutex_unlock(&pPre -> lock);
+			break;
+		}
+		// 그 사이 다른 스레드가 바꿈, 다시 검색
+		pthread_mutex_unlock(&pPre -> lock);
+	}
+	atomic_fetch_add(&pTree -> count, 1);
+	_leave(pThread);
+	return 1;
+}
+
+/* Deletes a node with keyPtr from the tree
+	부모와 대상 노드를 잠그고 (항상 조상 -> 자손 순서로 잠금) 링크가 그대로인지 확인한 뒤
+	자식이 하나 이하이면 부모 링크를 자식으로 바꿈
+	자식이 둘이면 대상에서 후속자까지의 경로를 복사해 (대상 자리에 후속자 data) 부모 링크 하나로 바꿈
+	(제자리에서 후속자를 옮기면 그 경로를 지나던 락 없는 검색이 후속자 키를 놓칠 수 있음)
+	경로 복사 중 메모리가 부족하면 트리를 바꾸지 않고 0 (overflow) 을 돌려줌
+	return	0 overflow
+			1 deleted
+			2 not found
+*/
+int CBST_Delete( CTHREAD *pThread, void *keyPtr){
+	CTREE *pTree = pThread -> tree;
+	CNODE *pPre, *pLoc;
+	int dir;
+
+	_enter(pThread);
+	while(1){
+		int found = _find(pTree, keyPtr, &pPre, &pLoc, &dir);
+
+		if(!found){
+			_leave(pThread);
+			return 2;
+		}
+
+		pthread_mutex_lock(&pPre -> lock);
+		pthread_mutex_lock(&pLoc -> lock);
+		if(atomic_load(&pPre -> marked) || atomic_load(&pLoc -> marked) || atomic_load(_child(pPre, dir)) != pLoc){
+			pthread_mutex_unlock(&pLoc -> lock);
+			pthread_mutex_unlock(&pPre -> lock);
+			continue;
+		}
+
+		CNODE *left = atomic_load(&pLoc -> left);
+		CNODE *right = atomic_load(&pLoc -> right);
+
+		if(left == NULL || right == NULL){
+			atomic_store(&pLoc -> marked, 1);
+			atomic_store_explicit(_child(pPre, dir), left != NULL ? left : right, memory_order_release);
+			pthread_mutex_unlock(&pLoc -> lock);
+			pthread_mutex_unlock(&pPre -> lock);
+			break;
+		}
+
+		// 자식이 둘: 대상부터 후속자(오른쪽 서브트리의 최소값)까지의 경로를 복사해서 한 번에 바꿈
+		// 경로의 노드를 위에서부터 잠그므로 (부모를 잠근 뒤 자식) 경로의 링크는 바뀌지 않음
+		CNODE *succ = right;
+		CNODE *next;
+
+		pthread_mutex_lock(&succ -> lock);
+		while((next = atomic_load(&succ -> left)) != NULL){
+			pthread_mutex_lock(&next -> lock);
+			succ = next;
+		}
+
+		// 새 경로: 대상 자리에는 후속자 data, 그 아래 (right .. 후속자의 부모) 는 같은 data 의 복사본
+		// 경로 밖의 서브트리는 옛 경로와 새 경로가 함께 가리킴
+		CNODE *copy = _makeNode(succ -> dataPtr);
+		CNODE *tail = copy;
+		int ok = copy != NULL;
+
+		if(ok) atomic_init(&copy -> left, left);
+		for(CNODE *cur = right; ok && cur != succ; cur = atomic_load(&cur -> left)){
+			CNODE *c = _makeNode(cur -> dataPtr);
+
+			if(c == NULL){
+				ok = 0;
+				break;
+			}
+			atomic_init(&c -> right, atomic_load(&cur -> right));
+			atomic_init(tail == copy ? &tail -> right : &tail -> left, c);
+			tail = c;
+		}
+		if(ok) atomic_init(tail == copy ? &tail -> right : &tail -> left, atomic_load(&succ -> right));
+
+		// 옛 경로를 떼어 낸 것으로 표시하고 (이 노드들을 잠그는 쓰기 스레드는 다시 검색) 새 경로를 연결
+		// 옛 경로 안을 지나는 검색은 그대로 옛 (바뀌지 않은) 노드들을 봄
+		if(ok){
+			atomic_store(&pLoc -> marked, 1);
+			for(CNODE *cur = right; cur != NULL; cur = atomic_load(&cur -> left)){
+				atomic_store(&cur -> marked, 1);
+			}
+			atomic_store_explicit(_child(pPre, dir), copy, memory_order_release);
+		}
+
+		for(CNODE *cur = right; cur != NULL; ){
+			next = atomic_load(&cur -> left);
+			pthread_mutex_unlock(&cur -> lock);
+			if(ok){
+				// 경로의 data 는 새 노드로 옮겼으므로 노드만 해제
+				cur -> ownsData = 0;
+				_retire(pThread, cur);
+			}
+			cur = next;
+		}
+		pthread_mutex_unlock(&pLoc -> lock);
+		pthread_mutex_unlock(&pPre -> lock);
+
+		if(!ok){
+			// 만든 복사본만 해제 (copy 는 right, 그 아래는 left 로 이어짐)
+			for(CNODE *cur = copy; cur != NULL; ){
+				next = cur == tail ? NULL : atomic_load(cur == copy ? &cur -> right : &cur -> left);
+				_freeNode(pTree, cur);
+				cur = next;
+			}
+			_leave(pThread);
+			return 0;
+		}
+		break;
+	}
+	pLoc -> ownsData = 1;
+	_retire(pThread, pLoc);
+	atomic_fetch_sub(&pTree -> count, 1);
+	_leave(pThread);
+	return 1;
+}
+
+/* Retrieve tree for the node containing the requested key (keyPtr)
+	return	1 found
+			0 not found
+*/
+int CBST_Search( CTHREAD *pThread, void *keyPtr, void (*callback)(void *)){
+	CNODE *pPre, *pLoc;
+	int dir;
+
+	_enter(pThread);
+	int found = _find(pThread -> tree, keyPtr, &pPre, &pLoc, &dir);
+
+	// epoch 안에 있는 동안은 찾은 노드와 data 가 해제되지 않음
+	if(found && callback != NULL) callback(pLoc -> dataPtr);
+	_leave(pThread);
+	return found;
+}
+
+/* traverses tree using inorder traversal
+*/
+void CBST_Traverse( CTHREAD *pThread, void (*callback)(const void *)){
+	_enter(pThread);
+	_traverse(atomic_load(&pThread -> tree -> head.left), callback);
+	_leave(pThread);
+}
+
+/* returns number of nodes in tree
+*/
+int CBST_Count( CTREE *pTree){
+	return atomic_load(&pTree -> count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// internal functions
+
+static CNODE *_makeNode( void *dataInPtr){
+	CNODE *node = malloc(sizeof(CNODE));
+	if(node == NULL) return NULL;
+
+	node -> dataPtr = dataInPtr;
+	atomic_init(&node -> left, NULL);
+	atomic_init(&node -> right, NULL);
+	atomic_init(&node -> marked, 0);
+	node -> ownsData = 0;
+	node -> limbo = NULL;
+	pthread_mutex_init(&node -> lock, NULL);
+	return node;
+}
+
+static void _freeNode( CTREE *pTree, CNODE *node){
+	if(node -> ownsData && pTree -> freeData != NULL) pTree -> freeData(node -> dataPtr);
+	pthread_mutex_destroy(&node -> lock);
+	free(node);
+}
+
+static void _freeList( CTREE *pTree, CNODE *node){
+	while(node != NULL){
+		CNODE *next = node -> limbo;
+		_freeNode(pTree, node);
+		node = next;
+	}
+}
+
+// internal search function
+// 락 없이 키를 찾아 내려감 (sentinel head 부터, head 는 모든 키보다 크므로 root 는 head 의 왼쪽 자식)
+// return	1 found (*pLoc = node, *pPre 의 *pDir 쪽 자식)
+//			0 not found (*pPre 의 *pDir 쪽 자식 자리가 비어 있음)
+static int _find( CTREE *pTree, void *keyPtr, CNODE **pPre, CNODE **pLoc, int *pDir){
+	CNODE *pre = &pTree -> head;
+	CNODE *cur = atomic_load_explicit(&pre -> left, memory_order_acquire);
+	int dir = 0;
+
+	while(cur != NULL){
+		int c = pTree -> compare(keyPtr, cur -> dataPtr);
+
+		if(c == 0) break;
+		pre = cur;
+		dir = c > 0;
+		cur = atomic_load_explicit(_child(cur, dir), memory_order_acquire);
+	}
+	*pPre = pre;
+	*pLoc = cur;
+	*pDir = dir;
+	return cur != NULL;
+}
+
+// 연산 시작: 전역 epoch 를 자기 epoch 로 공개
+// 마지막으로 본 epoch 보다 전역 epoch 가 커졌으면, 두 epoch 전 이전에 모은 노드를 해제
+// (전역 epoch 는 모든 연산 중인 스레드가 같은 epoch 에 있을 때만 1 증가하므로,
+//  e 에 떼어 낸 노드를 볼 수 있었던 스레드는 전역 epoch 가 e + 2 가 되기 전에 모두 연산을 마침)
+static void _enter( CTHREAD *pThread){
+	unsigned long e = atomic_load(&pThread -> tree -> epoch);
+
+	atomic_store(&pThread -> epoch, (e << 1) | 1);
+	if(pThread -> seen != e){
+		CNODE **limbo = &pThread -> limbo[(e + 1) % 3];
+
+		_freeList(pThread -> tree, *limbo);
+		*limbo = NULL;
+		pThread -> seen = e;
+	}
+}
+
+// 연산 끝
+static void _leave( CTHREAD *pThread){
+	atomic_store_explicit(&pThread -> epoch, 0, memory_order_release);
+}
+
+// 떼어 낸 노드를 해제 대기 리스트에 넣음
+// 노드를 뗀 뒤의 전역 epoch 로 분류 (자기 epoch 는 전역보다 하나 작을 수 있음)
+static void _retire( CTHREAD *pThread, CNODE *node){
+	unsigned long e = atomic_load(&pThread -> tree -> epoch);
+
+	node -> limbo = pThread -> limbo[e % 3];
+	pThread -> limbo[e % 3] = node;
+	if(++pThread -> retired >= CBST_RETIRE_BATCH){
+		pThread -> retired = 0;
+		_advance(pThread -> tree);
+	}
+}
+
+// 연산 중인 모든 스레드가 현재 전역 epoch 에 있으면 전역 epoch 를 1 증가
+static void _advance( CTREE *pTree){
+	unsigned long e = atomic_load(&pTree -> epoch);
+
+	for(int i = 0; i < CBST_MAX_THREADS; i++){
+		unsigned long v = atomic_load(&pTree -> threads[i].epoch);
+
+		if((v & 1) && (v >> 1) != e) return;
+	}
+	atomic_compare_exchange_strong(&pTree -> epoch, &e, e + 1);
+}
+
+// used in CBST_Traverse
+// 명시적 스택으로 중위 순회 (균형을 맞추지 않는 트리라 깊이가 n 까지 될 수 있으므로 재귀를 쓰지 않음)
+// 스택은 두 배씩 늘리고, 늘리지 못하면 거기서 멈춤
+static void _traverse( CNODE *root, void (*callback)(const void *)){
+	int capacity = 64;
+	int top = 0;
+	CNODE **stack = malloc(sizeof(CNODE *) * capacity);
+	if(stack == NULL) return;
+
+	CNODE *cur = root;
+	while(cur != NULL || top > 0){
+		while(cur != NULL){
+			if(top == capacity){
+				CNODE **newStack = realloc(stack, sizeof(CNODE *) * capacity * 2);
+				if(newStack == NULL){
+					free(stack);
+					return;
+				}
+				stack = newStack;
+				capacity *= 2;
+			}
+			stack[top++] = cur;
+			cur = atomic_load_explicit(&cur -> left, memory_order_acquire);
+		}
+		cur = stack[--top];
+		callback(cur -> dataPtr);
+		cur = atomic_load_explicit(&cur -> right, memory_order_acquire);
+	}
+	free(stack);
+}
@@ -0,0 +1,109 @@
+#ifndef CBST_H
+#define CBST_H
+
+#include <pthread.h> // pthread_mutex_t
+#include <stdatomic.h> // _Atomic
+
+////////////////////////////////////////////////////////////////////////////////
+// CTREE type definition
+// 여러 스레드가 함께 쓰는 이진 탐색 트리 (균형을 맞추지 않음, BST_PLAIN 과 같은 모양)
+// 키가 무작위 순서로 들어온다고 가정 (정렬된 순서로 넣으면 높이가 n 이 되어 검색/삽입/삭제가 O(n))
+// 정렬된 입력은 섞어서 넣거나, bst.h 의 BST_AVL 트리를 pthread_rwlock 으로 감싸서 사용
+//	읽기	CBST_Search 는 락 없이 child pointer 만 따라 내려감 (쓰기 스레드를 기다리지 않음)
+//	쓰기	바꿀 링크를 가진 노드(부모, 대상)만 잠그고, 잠근 뒤 링크가 그대로인지 확인 (아니면 다시 검색)
+//			자식이 둘인 노드는 후속자(successor)까지의 경로를 복사해서 링크 하나로 바꿈 (RCU 방식)
+//			옛 경로를 지나는 검색은 바뀌지 않은 옛 노드들을 그대로 봄
+//	해제	떼어 낸 노드와 삭제한 data 는 바로 free 하지 않고 epoch 기반으로 모아 두었다가
+//			그 노드를 볼 수 있었던 스레드가 모두 연산을 마친 뒤 해제 (epoch-based reclamation)
+// 트리를 쓰는 스레드는 각자 CBST_Attach 로 받은 CTHREAD 를 연산에 넘김
+typedef struct cnode
+{
+	void			*dataPtr;
+	_Atomic(struct cnode *)	left;
+	_Atomic(struct cnode *)	right;
+	atomic_int		marked;	// 1 if 트리에서 떼어 냄 (잠근 뒤 확인)
+	int				ownsData;	// 1 if 해제할 때 data 도 freeData 로 해제 (삭제한 키)
+	struct cnode	*limbo;	// 해제 대기 리스트의 다음 노드
+	pthread_mutex_t	lock;
+} CNODE;
+
+// 트리를 동시에 쓸 수 있는 최대 스레드 수
+#define CBST_MAX_THREADS	64
+
+// 스레드별 상태 (다른 스레드가 읽는 값은 cache line 하나에 따로 둠)
+typedef struct
+{
+	_Atomic unsigned long	epoch;	// (epoch << 1) | 1 while 연산 중, 0 otherwise
+	atomic_int		used;	// 1 if attached
+	unsigned long	seen;	// 마지막으로 본 전역 epoch
+	CNODE			*limbo[3];	// epoch % 3 별 해제 대기 노드
+	int				retired;	// 마지막 epoch 진행 시도 이후 모은 노드 수
+	struct ctree	*tree;
+} __attribute__((aligned(64))) CTHREAD;
+
+typedef struct ctree
+{
+	CNODE		head;	// sentinel: 모든 키보다 큰 노드, root 는 head.left
+	atomic_int	count;
+	int			(*compare)(const void *, const void *);
+	void		(*freeData)(void *);	// 삭제한 data 를 해제하는 함수 (NULL if 해제하지 않음)
+	_Atomic unsigned long	epoch;	// 전역 epoch
+	CTHREAD		threads[CBST_MAX_THREADS];
+} CTREE;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a concurrent tree head node
+	freeData	CBST_Delete 로 지운 data 를 더 이상 읽는 스레드가 없을 때 해제하는 함수 (NULL 가능)
+	return	head node pointer
+			NULL if overflow
+*/
+CTREE *CBST_Create( int (*compare)(const void *, const void *), void (*freeData)(void *));
+
+/* Deletes all nodes, pending nodes and the head node (다른 스레드가 모두 detach 한 뒤 호출)
+	callback	트리에 남은 data 에 대해 호출 (NULL 가능)
+*/
+void CBST_Destroy( CTREE *pTree, void (*callback)(void *));
+
+/* Registers the calling thread
+	return	thread handle (이 스레드에서만 사용)
+			NULL if CBST_MAX_THREADS 개가 모두 사용 중
+*/
+CTHREAD *CBST_Attach( CTREE *pTree);
+
+/* Unregisters the thread (해제 대기 노드는 다음에 같은 슬롯을 쓰는 스레드나 CBST_Destroy 가 해제)
+*/
+void CBST_Detach( CTHREAD *pThread);
+
+/* Inserts new data into the tree
+	return	0 overflow
+			1 success
+			2 if duplicated key
+*/
+int CBST_Insert( CTHREAD *pThread, void *dataInPtr);
+
+/* Deletes a node with keyPtr from the tree (data 는 안전해진 뒤 freeData 로 해제)
+	return	0 overflow (자식이 둘인 노드의 경로 복사 실패, 트리는 그대로)
+			1 deleted
+			2 not found
+*/
+int CBST_Delete( CTHREAD *pThread, void *keyPtr);
+
+/* Retrieve tree for the node containing the requested key (keyPtr), 락 없음
+	callback	찾은 data 로 호출 (NULL 가능), callback 안에서는 data 가 해제되지 않음
+	return	1 found
+			0 not found
+*/
+int CBST_Search( CTHREAD *pThread, void *keyPtr, void (*callback)(void *));
+
+/* traverses tree using inorder traversal (다른 스레드의 삽입/삭제와 동시에 호출 가능, 순간 스냅샷은 아님)
+	명시적 스택을 사용하므로 트리 깊이에 제한 없음
+*/
+void CBST_Traverse( CTHREAD *pThread, void (*callback)(const void *));
+
+/* returns number of nodes in tree
+*/
+int CBST_Count( CTREE *pTree);
+
+#endif
@@ -1,29 +1,30 @@
 #include <stdio.h>
 #include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <string.h> // strcmp, strlen, memcpy, memcmp
+#include <pthread.h> // pthread_create
+
+#include "../../common/arena.h"
+#include "../../common/freq_bucket.h"
+#include "../../common/tokenizer.h"
+#include "../../common/word.h"
+
 // multi-linked list + 정렬된(ordered) 선형리스트)
 #define SORT_BY_WORD    0 // 단어 순 정렬
 #define SORT_BY_FREQ    1 // 빈도 순 정렬
-
-// User structure type definition
-// 단어 구조체
-typedef struct {
-    char    *word;        // 단어
-    int        freq;        // 빈도
-} tWord;
+#define TOP_BY_FREQ     2 // 빈도 순 상위 K 개만
 
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
 typedef struct node{
-    tWord        *dataPtr;
+    FNODE    fnode; // 단어 구조체와 빈도순 리스트를 위한 포인터 (첫 멤버, common/freq_bucket.h)
     struct node    *link; // 단어순 리스트를 위한 포인터
-    struct node    *link2; // 빈도순 리스트를 위한 포인터
 } NODE;
 
 typedef struct{
     int        count;// 노드  개수
     NODE    *head; // 단어순 리스트의 첫번째 노드에 대한 포인터
-    NODE    *head2; // 빈도순 리스트의 첫번째 노드에 대한 포인터
+    FREQ_INDEX    index; // 빈도 bucket (빈도순 보기)
+    BLOCK    *arena; // 단어 구조체, 단어 문자열, 노드, bucket 을 저장하는 아레나
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,7 +36,7 @@ typedef struct{
 LIST *createList(void);
 
 
-//  단어 리스트에 할당된 메모리를 해제 (head node, data node, word data)
+//  단어 리스트에 할당된 메모리를 해제 (head node, arena blocks)
 void destroyList( LIST *pList);
 
 // internal search function
@@ -45,8 +46,6 @@ void destroyList( LIST *pList);
 //             0 not found
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu);
 
-static int _search_by_freq( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu);
-
 // internal insert function
 // inserts data into a new node
 // for addNode function
@@ -54,59 +53,95 @@ static int _search_by_freq( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu)
 //             0 if memory overflow
 static int _insert( LIST *pList, NODE *pPre, tWord *dataInPtr);
 
-// Inserts data into list
+// Inserts word into list
+// 새 단어만 아레나에 복사하고, 이미 저장된 단어는 메모리 할당 없이 빈도만 증가
 // return    0 if overflow
 //            1 if successful
 //            2 if duplicated key (이미 저장된 단어는 빈도 증가)
-int addNode( LIST *pList, tWord *dataInPtr);
+int addNode( LIST *pList, char *word);
+
+// Inserts a batch of words into list
+// batch 를 단어순으로 정렬해서 같은 단어를 하나로 모은 뒤, 단어순 리스트와 한 번에 병합 (O(count + n log n))
+// 같은 단어의 개수는 빈도에 한 번에 더함
+//    batch    검색용 키 구조체(set_key) 에 대한 pointer n 개 (정렬되어 순서가 바뀜)
+// return    0 if overflow
+//            1 if successful
+int addNodes( LIST *pList, tWord **batch, int n);
 
 // internal function
-// for connect_by_frequency function
-// connects node into a frequency list
-static void _link_by_freq( LIST *pList, NODE *pPre, NODE *pLoc);
+// for addNodes function
+// qsort 로 batch (tWord * 배열) 를 정렬하기 위한 비교 함수
+static int _compare_key( const void *p1, const void *p2);
 
-// 단어순 리스트를 순회하며 빈도순 리스트로 연결
+// 빈도순 보기의 같은 빈도 안의 단어들을 단어순으로 정리
+// (빈도순 bucket 은 addNode 에서 항상 최신으로 유지됨)
 void connect_by_frequency( LIST *list);
 
 // 사전을 화면에 출력 ("단어\t빈도" 형식)
 void print_dic( LIST *pList); // 단어순
 void print_dic_by_freq( LIST *pList); // 빈도순
 
-// 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
+// internal function
+// for top_by_freq function
+// heap[0..n-1] 은 compare_by_freq 기준 max-heap (루트가 지금까지 고른 단어 중 빈도순으로 가장 뒤)
+static void _sift_up( tWord **heap, int i);
+static void _sift_down( tWord **heap, int n, int i);
+
+// 빈도순(compare_by_freq) 상위 k 개 단어를 out 에 빈도순으로 저장
+// 빈도 bucket 을 위에서부터 k 개가 찰 때까지만 보고, 마지막 bucket 은 크기 k 의 힙으로 일부만 고름
+// 단어를 입력하는 중에도 언제든 현재 상위 단어를 얻을 수 있음
+//    out    tWord * k 개를 저장할 배열
+// return    저장한 단어 수 (단어가 k 개보다 적으면 전체 단어 수)
+int top_by_freq( LIST *pList, int k, tWord **out);
+
+// 빈도순 상위 k 개 단어를 print_dic_by_freq 와 같은 형식으로 출력
+// return    1 if successful
+//            0 if overflow
+int print_dic_top( LIST *pList, int k);
+
+// internal function
+// 단어 구조체와 단어 문자열을 아레나에 할당하고 word, freq 초기화 (common/word.h 의 initWord)
+// word 는 len 바이트 ('\0' 으로 끝나지 않는 mmap 된 단어도 됨)
 // for addNode function
 // return    할당된 단어 구조체에 대한 pointer
 //            NULL if overflow
-tWord *createWord( char *word);
-
-//  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
-void destroyWord( tWord *pNode);
+static tWord *_create_word( LIST *pList, const char *word, size_t len);
 
 ////////////////////////////////////////////////////////////////////////////////
-// compares two words in word structures
-// for _search function
-// 정렬 기준 : 단어
-int compare_by_word( const void *n1, const void *n2)
-{
-    tWord *p1 = (tWord *)n1;
-    tWord *p2 = (tWord *)n2;
-    
-    return strcmp( p1->word, p2->word);
-}
+// 단어 파일 읽기 (TOKENIZER 는 common/tokenizer.h)
+
+// addNodes 한 번에 넘기는 단어 수
+#define BATCH_SIZE    4096
+
+// pTok 의 남은 단어를 BATCH_SIZE 개씩 모아 addNodes 로 사전에 넣음
+// 키 구조체는 mmap 된 단어를 가리키므로 closeTokenizer 전에 불러야 함
+// return    1 if successful
+//            0 if overflow
+int addTokens( LIST *pList, TOKENIZER *pTok);
+
 ////////////////////////////////////////////////////////////////////////////////
-// for _search_by_freq function
-// 정렬 기준 : 빈도 내림차순(1순위), 단어(2순위)
-int compare_by_freq( const void *n1, const void *n2)
-{
-    tWord *p1 = (tWord *)n1;
-    tWord *p2 = (tWord *)n2;
-    
-    int ret = (int) p2->freq - p1->freq;
-    
-    if (ret != 0) return ret;
-    
-    return strcmp( p1->word, p2->word);
-}
+// 병렬 단어 세기
+// 파일을 공백 경계에 맞춘 nThreads 개의 범위로 나누고, 각 스레드가 자기 범위를
+// 개별 사전(LIST)에 센 뒤 mergeList 로 하나의 사전에 합침
+
+// 스레드 하나가 맡는 입력 범위와 개별 사전
+typedef struct{
+    TOKENIZER    tok; // 맡은 범위 (파일 mmap 의 일부를 가리킴)
+    LIST    *list; // 개별 사전
+    int        ret; // 1 if successful, 0 if overflow
+} WORKER;
+
+// 단어순으로 정렬된 src 의 노드를 dst 에 병합 (같은 단어는 빈도 합산)
+// src 의 노드와 아레나 블록은 dst 로 옮겨지고 src head 는 해제됨
+// 빈도가 한 번에 여러 칸 바뀌므로 dst 의 빈도 bucket 은 다시 만듦
+// return    1 if successful
+//            0 if overflow
+int mergeList( LIST *dst, LIST *src);
+
+// pTok 의 파일을 nThreads 개 스레드로 나누어 세고 결과를 list 에 병합
+// return    1 if successful
+//            0 if overflow or cannot create thread
+int count_parallel( LIST *list, TOKENIZER *pTok, int nThreads);
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -114,19 +149,38 @@ int main( int argc, char **argv)
 {
     LIST *list;
     int option;
-    FILE *fp;
-    char word[100];
-    tWord *pWord;
-    int ret;
+    TOKENIZER tok;
+    int nThreads = 1;
+    int topK = 0;
+    int arg = 2;    // FILE 인자의 위치 (-t K 이면 하나 뒤)
     
-    if (argc != 3)
+    // -t K : option 이 인자 두 개를 차지하므로 FILE 과 THREADS 위치가 하나씩 밀림
+    if (argc > 2 && strcmp( argv[1], "-t") == 0)
     {
-        fprintf( stderr, "Usage: %s option FILE\n\n", argv[0]);
-        fprintf( stderr, "option\n\t-w\t\tsort by word\n\t-f\t\tsort by frequency\n");
+        if ((topK = atoi( argv[2])) < 1)
+        {
+            fprintf( stderr, "invalid K : %s\n", argv[2]);
+            return 1;
+        }
+        arg = 3;
+    }
+    
+    if (argc != arg + 1 && argc != arg + 2)
+    {
+        fprintf( stderr, "Usage: %s option FILE [THREADS]\n\n", argv[0]);
+        fprintf( stderr, "option\n\t-w\t\tsort by word\n\t-f\t\tsort by frequency\n\t-t K\t\ttop K words by frequency\n");
+        fprintf( stderr, "THREADS\n\tnumber of counting threads (default 1)\n");
+        return 1;
+    }
+    
+    if (argc == arg + 2 && (nThreads = atoi( argv[arg + 1])) < 1)
+    {
+        fprintf( stderr, "invalid number of threads : %s\n", argv[arg + 1]);
         return 1;
     }
 
-    if (strcmp( argv[1], "-w") == 0) option = SORT_BY_WORD;
+    if (topK > 0) option = TOP_BY_FREQ;
+    else if (strcmp( argv[1], "-w") == 0) option = SORT_BY_WORD;
     else if (strcmp( argv[1], "-f") == 0) option = SORT_BY_FREQ;
     else {
         fprintf( stderr, "unknown option : %s\n", argv[1]);
@@ -142,33 +196,41 @@ int main( int argc, char **argv)
         return 100;
     }
 
-    if ((fp = fopen( argv[2], "r")) == NULL)
+    if (!openTokenizer( &tok, argv[arg]))
     {
-        fprintf( stderr, "cannot open file : %s\n", argv[2]);
+        fprintf( stderr, "cannot open file : %s\n", argv[arg]);
         return 2;
     }
     
-    while(fscanf( fp, "%s", word) != EOF)
+    if (nThreads > 1)
     {
-        pWord = createWord( word);
-        
-        // 사전(단어순 리스트) 업데이트
-        // 이미 저장된 단어는 빈도 증가
-        ret = addNode( list, pWord);
-        
-        if (ret == 0 || ret == 2) // failure or duplicated
+        if (!count_parallel( list, &tok, nThreads))
         {
-            destroyWord( pWord);
+            fprintf( stderr, "memory overflow\n");
         }
     }
+    // 사전(단어순 리스트) 업데이트
+    // 이미 저장된 단어는 빈도 증가
+    else if (!addTokens( list, &tok))
+    {
+        fprintf( stderr, "memory overflow\n");
+    }
     
-    fclose( fp);
+    closeTokenizer( &tok);
 
     if (option == SORT_BY_WORD) {
         
         // 단어순 리스트를 화면에 출력
         print_dic( list);
     }
+    else if (option == TOP_BY_FREQ) {
+        
+        // 빈도순 상위 K 개만 골라서 출력 (빈도순 리스트를 만들지 않음)
+        if (!print_dic_top( list, topK))
+        {
+            fprintf( stderr, "memory overflow\n");
+        }
+    }
     else { // SORT_BY_FREQ
     
         // 빈도순 리스트 연결
@@ -187,28 +249,20 @@ int main( int argc, char **argv)
 
 //이제 함수 작성할 거임. 함수 쓰이는 흐름대로
 
-// 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
+// internal function
+// 단어 구조체와 단어 문자열을 아레나에 할당하고 word, freq 초기화 (common/word.h 의 initWord)
+// word 는 len 바이트 ('\0' 으로 끝나지 않는 mmap 된 단어도 됨)
 // for addNode function
 // return    할당된 단어 구조체에 대한 pointer
 //            NULL if overflow
-tWord *createWord(char *word){
-    
-    tWord *newWord = malloc(sizeof(tWord));
-    if(newWord == NULL) return NULL;
-    
-    newWord -> word = strdup(word);
-    newWord -> freq = 1;
+static tWord *_create_word( LIST *pList, const char *word, size_t len){
+    // 긴 단어만 문자열을 구조체 바로 뒤에 저장
+    void *pWord = arenaAlloc(&pList -> arena, word_size(len));
+    if(pWord == NULL) return NULL;
     
-    return newWord;
-}
-//  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
-void destroyWord( tWord *pNode){
-    if(pNode != NULL){
-        free(pNode -> word);
-        free(pNode);
-    }
+    return initWord(pWord, word, len);
 }
+
 // Allocates dynamic memory for a list head node and returns its address to caller
 // return    head node pointer
 //             NULL if overflow
@@ -218,21 +272,15 @@ LIST *createList(void){
     
     list -> count = 0;
     list -> head = NULL;
-    list -> head2 = NULL;
+    initFreqIndex(&list -> index);
+    list -> arena = NULL;
     
     return list;
 }
-//  단어 리스트에 할당된 메모리를 해제 (head node, data node, word data)
+//  단어 리스트에 할당된 메모리를 해제 (head node, arena blocks)
+// 노드와 단어는 모두 아레나에 있으므로 블록만 해제
 void destroyList( LIST *pList){
-    NODE *cur = pList -> head;
-    NODE *temp;
-    
-    while(cur != NULL){
-        temp = cur -> link;
-        destroyWord(cur -> dataPtr);
-        free(cur);
-        cur = temp;
-    }
+    destroyArena(pList -> arena);
     free(pList);
 }
 // internal search function
@@ -244,14 +292,14 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu){
     NODE *cur = pList -> head;
     NODE *prev = NULL;
     
-    while(cur != NULL && compare_by_word(cur -> dataPtr, pArgu) < 0){
+    while(cur != NULL && compare_by_word(cur -> fnode.dataPtr, pArgu) < 0){
         prev = cur;
         cur = cur -> link;
     }
     *pPre = prev;
     *pLoc = cur;
     
-    if(cur != NULL && compare_by_word(cur -> dataPtr, pArgu) == 0){
+    if(cur != NULL && compare_by_word(cur -> fnode.dataPtr, pArgu) == 0){
         return 1;
     }
     else{
@@ -264,12 +312,12 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu){
 // return    1 if successful
 //             0 if memory overflow
 static int _insert( LIST *pList, NODE *pPre, tWord *dataInPtr){
-    NODE *newNode = malloc(sizeof(NODE));
+    NODE *newNode = arenaAlloc(&pList -> arena, sizeof(NODE));
     if(newNode == NULL) return 0;
     
-    newNode -> dataPtr = dataInPtr;
+    newNode -> fnode.dataPtr = dataInPtr;
     newNode -> link = NULL;
-    newNode -> link2 = NULL;
+    if(!addFreqNode(&pList -> index, &pList -> arena, &newNode -> fnode)) return 0;
     
     if(pPre == NULL){
         newNode -> link = pList -> head; // 이 부분은 이해가 갔는데
@@ -283,99 +331,346 @@ static int _insert( LIST *pList, NODE *pPre, tWord *dataInPtr){
     pList -> count++;
     return 1;
 }
-// Inserts data into list
+// Inserts word into list
+// 새 단어만 아레나에 복사하고, 이미 저장된 단어는 메모리 할당 없이 빈도만 증가
 // return    0 if overflow
 //            1 if successful
 //            2 if duplicated key (이미 저장된 단어는 빈도 증가)
-int addNode( LIST *pList, tWord *dataInPtr){
+int addNode( LIST *pList, char *word){
     NODE *pPre;
     NODE *pLoc;
+    tWord key; // 검색용 (긴 단어는 복사하지 않음)
     
-    int found = _search(pList, &pPre, &pLoc, dataInPtr);
+    set_key(&key, word);
+    int found = _search(pList, &pPre, &pLoc, &key);
     
     if(found == 1){
-        pLoc -> dataPtr -> freq++;
+        // 빈도 증가, 빈도순 bucket 도 한 칸 위로
+        if(!incFreqNode(&pList -> index, &pList -> arena, &pLoc -> fnode, 1)) return 0;
         return 2;
     }
     
-    int success = _insert(pList, pPre, dataInPtr);
+    tWord *pWord = _create_word(pList, word, key.len);
+    if(pWord == NULL) return 0;
+    
+    int success = _insert(pList, pPre, pWord);
     if(!success) return 0;
     
     return 1;
 }
+
+// Inserts a batch of words into list
+// batch 를 단어순으로 정렬해서 같은 단어를 하나로 모은 뒤, 단어순 리스트와 한 번에 병합
+// 키가 정렬되어 있으므로 리스트는 처음부터 끝까지 한 번만 훑음 (키마다 head 부터 검색하지 않음)
+int addNodes( LIST *pList, tWord **batch, int n){
+    NODE *pPre = NULL;
+    NODE *pLoc = pList -> head;
+    
+    qsort(batch, n, sizeof(tWord *), _compare_key);
+    
+    for(int i = 0; i < n; ){
+        tWord *key = batch[i];
+        int count = 1;
+        int cmp = 1;
+        
+        // 같은 단어는 하나로 모아 개수만 셈
+        while(i + count < n && compare_by_word(batch[i + count], key) == 0){
+            count++;
+        }
+        i += count;
+        
+        // 앞의 키보다 뒤에 있으므로 지난번 위치부터 계속 검색
+        while(pLoc != NULL && (cmp = compare_by_word(pLoc -> fnode.dataPtr, key)) < 0){
+            pPre = pLoc;
+            pLoc = pLoc -> link;
+        }
+        
+        if(pLoc != NULL && cmp == 0){
+            if(!incFreqNode(&pList -> index, &pList -> arena, &pLoc -> fnode, count)) return 0;
+            continue;
+        }
+        
+        tWord *pWord = _create_word(pList, get_word(key), key -> len);
+        if(pWord == NULL) return 0;
+        
+        pWord -> freq = count;
+        if(!_insert(pList, pPre, pWord)) return 0;
+        
+        // 새 노드 다음부터 계속
+        pPre = pPre != NULL ? pPre -> link : pList -> head;
+    }
+    return 1;
+}
+
+// internal function
+// for addNodes function
+// qsort 로 batch (tWord * 배열) 를 정렬하기 위한 비교 함수
+static int _compare_key( const void *p1, const void *p2){
+    return compare_by_word(*(tWord * const *)p1, *(tWord * const *)p2);
+}
 // 사전을 화면에 출력 ("단어\t빈도" 형식)
 void print_dic( LIST *pList){
     NODE *cur = pList -> head;
     
     while(cur != NULL){
-        printf("%s %d\n", cur -> dataPtr -> word, cur -> dataPtr -> freq);
+        printf("%s %d\n", get_word(cur -> fnode.dataPtr), cur -> fnode.dataPtr -> freq);
         cur = cur -> link;
     }
 }
 
-static int _search_by_freq( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu){
-    NODE *cur = pList -> head2;
-    NODE *prev = NULL;
-    
-    while(cur != NULL && compare_by_freq(cur -> dataPtr, pArgu) < 0){
-        prev = cur;
-        cur =  cur -> link2;
+// 빈도순 보기의 같은 빈도 안의 단어들을 단어순으로 정리
+// 빈도순 bucket 은 addNode 에서 항상 최신이므로, 마지막 정리 이후 순서가 흐트러진 bucket 만 정렬
+void connect_by_frequency(LIST *list) {
+    for (BUCKET *pBucket = list->index.top; pBucket != NULL; pBucket = pBucket->down) {
+        sortBucket(pBucket);
     }
-    *pPre = prev;
-    *pLoc = cur;
-    if(cur != NULL && compare_by_freq(cur -> dataPtr, pArgu) == 0){
-        return 1;
+}
+
+// 빈도가 큰 bucket 부터 출력 (connect_by_frequency 이후에는 같은 빈도 안에서 단어순)
+void print_dic_by_freq( LIST *pList){
+    for(BUCKET *pBucket = pList -> index.top; pBucket != NULL; pBucket = pBucket -> down){
+        for(FNODE *cur = pBucket -> first; cur != NULL; cur = cur -> link2){
+            printf("%s %d\n", get_word(cur -> dataPtr), cur -> dataPtr -> freq);
+        }
     }
-    else{
-        return 0;
+}
+
+// internal function
+// for top_by_freq function
+// heap[i] 를 부모와 비교하며 위로 올림 (빈도순으로 뒤인 단어가 위로)
+static void _sift_up( tWord **heap, int i){
+    tWord *item = heap[i];
+    
+    while(i > 0){
+        int parent = (i - 1) / 2;
+        
+        if(compare_by_freq(heap[parent], item) >= 0) break;
+        heap[i] = heap[parent];
+        i = parent;
     }
+    heap[i] = item;
 }
 
-static void _link_by_freq( LIST *pList, NODE *pPre, NODE *pLoc){
+// internal function
+// for top_by_freq function
+// heap[i] 를 더 뒤인 자식과 비교하며 아래로 내림
+static void _sift_down( tWord **heap, int n, int i){
+    tWord *item = heap[i];
     
-    if(pPre == NULL){
-        pLoc -> link2 = pList -> head2;
-        pList -> head2 = pLoc;
+    while(2 * i + 1 < n){
+        int child = 2 * i + 1;
+        
+        if(child + 1 < n && compare_by_freq(heap[child + 1], heap[child]) > 0) child++;
+        if(compare_by_freq(item, heap[child]) >= 0) break;
+        heap[i] = heap[child];
+        i = child;
     }
-    else{
-        pLoc -> link2 = pPre -> link2;
-        pPre -> link2 = pLoc;
+    heap[i] = item;
+}
+
+// 빈도순(compare_by_freq) 상위 k 개 단어를 out 에 빈도순으로 저장
+// 통째로 들어가는 bucket 은 단어순으로 정리해서 복사하고,
+// 일부만 필요한 마지막 bucket 은 힙으로 고름: 힙이 차면 루트(고른 단어 중 가장 뒤)보다 앞서는 단어만 루트와 바꾼 뒤
+// 힙 정렬로 단어순(앞에서부터)으로 정리
+int top_by_freq( LIST *pList, int k, tWord **out){
+    BUCKET *pBucket = pList -> index.top;
+    int n = 0;
+    
+    for(; pBucket != NULL && pBucket -> count <= k - n; pBucket = pBucket -> down){
+        sortBucket(pBucket);
+        for(FNODE *cur = pBucket -> first; cur != NULL; cur = cur -> link2){
+            out[n++] = cur -> dataPtr;
+        }
+    }
+    if(pBucket == NULL || n == k) return n;
+    
+    tWord **heap = out + n;
+    int m = 0;
+    
+    for(FNODE *cur = pBucket -> first; cur != NULL; cur = cur -> link2){
+        if(m < k - n){
+            heap[m] = cur -> dataPtr;
+            _sift_up(heap, m++);
+        }
+        else if(compare_by_freq(cur -> dataPtr, heap[0]) < 0){
+            heap[0] = cur -> dataPtr;
+            _sift_down(heap, m, 0);
+        }
     }
+    
+    for(int i = m - 1; i > 0; i--){
+        tWord *temp = heap[0];
+        heap[0] = heap[i];
+        heap[i] = temp;
+        _sift_down(heap, i, 0);
+    }
+    return n + m;
 }
 
-void connect_by_frequency(LIST *list) {
-    NODE *cur = list->head;
-    list->head2 = NULL;
+// 빈도순 상위 k 개 단어를 print_dic_by_freq 와 같은 형식으로 출력
+int print_dic_top( LIST *pList, int k){
+    // 단어 수보다 큰 k 는 단어 수만큼만 할당
+    int size = k < pList -> count ? k : pList -> count;
+    tWord **top = malloc(sizeof(tWord *) * (size > 0 ? size : 1));
+    if(top == NULL) return 0;
+    
+    int n = top_by_freq(pList, k, top);
+    for(int i = 0; i < n; i++){
+        printf("%s %d\n", get_word(top[i]), top[i] -> freq);
+    }
+    free(top);
+    return 1;
+}
 
-    while (cur != NULL) {
-        NODE *pPre = NULL;
-        NODE *pLoc = list->head2;
+////////////////////////////////////////////////////////////////////////////////
+// 단어 파일 읽기
 
-        while (pLoc != NULL && compare_by_freq(cur->dataPtr, pLoc->dataPtr) > 0) {
-            pPre = pLoc;
-            pLoc = pLoc->link2;
+// pTok 의 남은 단어를 BATCH_SIZE 개씩 모아 addNodes 로 사전에 넣음
+// return    1 if successful
+//            0 if overflow
+int addTokens( LIST *pList, TOKENIZER *pTok){
+    tWord *keys = malloc(sizeof(tWord) * BATCH_SIZE);
+    tWord **batch = malloc(sizeof(tWord *) * BATCH_SIZE);
+    const char *word;
+    size_t len;
+    int n = 0;
+    int ret = keys != NULL && batch != NULL;
+    
+    while(ret && nextToken(pTok, &word, &len)){
+        set_key_len(&keys[n], word, len);
+        batch[n] = &keys[n];
+        
+        if(++n == BATCH_SIZE){
+            ret = addNodes(pList, batch, n);
+            n = 0;
         }
+    }
+    if(ret && n > 0){
+        ret = addNodes(pList, batch, n);
+    }
+    
+    free(keys);
+    free(batch);
+    return ret;
+}
 
-        // 빈도순 리스트에 노드 연결
-        if (pPre == NULL) {
-            cur->link2 = list->head2;
-            list->head2 = cur;
-        } else {
-            cur->link2 = pPre->link2;
-            pPre->link2 = cur;
+////////////////////////////////////////////////////////////////////////////////
+// 병렬 단어 세기
+
+// 단어순으로 정렬된 src 의 노드를 dst 에 병합 (같은 단어는 빈도 합산)
+// src 의 노드와 아레나 블록은 dst 로 옮겨지고 src head 는 해제됨
+// 빈도가 한 번에 여러 칸 바뀌므로 dst 의 빈도 bucket 은 다시 만듦
+int mergeList( LIST *dst, LIST *src){
+    NODE dummy;
+    NODE *tail = &dummy;
+    NODE *a = dst -> head;
+    NODE *b = src -> head;
+    
+    while(a != NULL && b != NULL){
+        int cmp = compare_by_word(a -> fnode.dataPtr, b -> fnode.dataPtr);
+        
+        if(cmp < 0){
+            tail -> link = a;
+            a = a -> link;
         }
-
-        cur = cur->link;
+        else if(cmp > 0){
+            tail -> link = b;
+            b = b -> link;
+            dst -> count++;
+        }
+        else{
+            // src 의 노드는 아레나에 남겨 두고 빈도만 합산
+            a -> fnode.dataPtr -> freq += b -> fnode.dataPtr -> freq;
+            tail -> link = a;
+            a = a -> link;
+            b = b -> link;
+        }
+        tail = tail -> link;
+    }
+    if(a != NULL){
+        tail -> link = a;
+    }
+    else{
+        tail -> link = b;
+        for(; b != NULL; b = b -> link){
+            dst -> count++;
+        }
+    }
+    dst -> head = dummy.link;
+    
+    // src 의 아레나 블록을 dst 의 현재 블록 뒤에 이어 붙임 (현재 블록은 그대로)
+    mergeArena(&dst -> arena, src -> arena);
+    free(src);
+    
+    // 단어순 리스트의 모든 노드를 link2 로 이어서 빈도 bucket 을 다시 만듦
+    FNODE *first = NULL;
+    FNODE **tail2 = &first;
+    
+    for(NODE *cur = dst -> head; cur != NULL; cur = cur -> link){
+        *tail2 = &cur -> fnode;
+        tail2 = &cur -> fnode.link2;
     }
+    *tail2 = NULL;
+    
+    return rebuildFreqIndex(&dst -> index, &dst -> arena, first);
 }
 
+// 스레드 함수: 맡은 범위의 단어를 개별 사전에 셈
+static void *_count_worker( void *arg){
+    WORKER *w = arg;
+    
+    w -> ret = addTokens(w -> list, &w -> tok);
+    return NULL;
+}
 
-void print_dic_by_freq( LIST *pList){
-    NODE *cur = pList -> head2;
+// pTok 의 파일을 nThreads 개 스레드로 나누어 세고 결과를 list 에 병합
+// 각 범위의 경계는 공백 문자 위에 오도록 뒤로 밀어서 단어가 잘리지 않게 함
+// (경계의 공백은 앞 범위의 끝이므로 '\0' 쓰기도 범위를 넘지 않음)
+// return    1 if successful
+//            0 if overflow or cannot create thread
+int count_parallel( LIST *list, TOKENIZER *pTok, int nThreads){
+    WORKER *workers = calloc(nThreads, sizeof(WORKER));
+    pthread_t *threads = calloc(nThreads, sizeof(pthread_t));
+    int ret = 1;
+    int started = 0;
+    size_t start = pTok -> pos;
     
-    while(cur != NULL){
-        printf("%s %d\n", cur -> dataPtr -> word, cur -> dataPtr -> freq);
-        cur = cur -> link2;
+    if(workers == NULL || threads == NULL){
+        free(workers);
+        free(threads);
+        return 0;
     }
+    
+    for(int i = 0; i < nThreads; i++){
+        size_t end = (i == nThreads - 1) ? pTok -> size : pTok -> pos + (pTok -> size - pTok -> pos) / nThreads * (i + 1);
+        
+        if(end < start) end = start;
+        end = tokenizerSplit(pTok, end);
+        
+        subTokenizer(&workers[i].tok, pTok, start, end);
+        workers[i].list = createList();
+        
+        if(workers[i].list == NULL || pthread_create(&threads[i], NULL, _count_worker, &workers[i]) != 0){
+            ret = 0;
+            break;
+        }
+        started++;
+        start = end;
+    }
+    
+    for(int i = 0; i < started; i++){
+        pthread_join(threads[i], NULL);
+        if(!workers[i].ret) ret = 0;
+        
+        if(!mergeList(list, workers[i].list)) ret = 0;
+        closeTokenizer(&workers[i].tok);
+    }
+    if(started < nThreads && workers[started].list != NULL){
+        destroyList(workers[started].list);
+    }
+    pTok -> pos = pTok -> size;
+    
+    free(workers);
+    free(threads);
+    return ret;
 }
-
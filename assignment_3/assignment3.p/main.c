@@ -1,7 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <string.h> // strcmp, strlen, memcpy, memcmp
+#include <stdint.h> // uint32_t
 #include <ctype.h> // toupper
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+
+#include "../../common/arena.h"
+#include "../../common/freq_bucket.h"
+#include "../../common/tokenizer.h"
+#include "../../common/word.h"
 
 #define QUIT            1
 #define FORWARD_PRINT    2
@@ -9,19 +19,13 @@
 #define SEARCH            4
 #define DELETE            5
 #define COUNT            6
-
-// User structure type definition
-// 단어 구조체
-typedef struct {
-    char    *word;        // 단어
-    int        freq;        // 빈도
-} tWord;
+#define FREQ_PRINT        7
 
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
 typedef struct node
 {
-    tWord        *dataPtr;
+    FNODE    fnode; // 단어 구조체와 빈도 bucket 안의 연결 (첫 멤버, common/freq_bucket.h)
     struct node    *llink; // backward pointer
     struct node    *rlink; // forward pointer
 } NODE;
@@ -31,6 +35,9 @@ typedef struct
     int        count;
     NODE    *head;
     NODE    *rear;
+    BLOCK    *arena; // 단어 구조체, 단어 문자열, 노드, bucket 을 저장하는 아레나
+    NODE    *freeNodes; // 삭제된 노드 (rlink 로 연결, _insert 에서 재사용)
+    FREQ_INDEX    index; // 빈도 bucket (빈도순 보기)
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -41,15 +48,24 @@ typedef struct
 //             NULL if overflow
 LIST *createList(void);
 
-//  단어 리스트에 할당된 메모리를 해제 (head node, data node, word data)
+//  단어 리스트에 할당된 메모리를 해제 (head node, arena blocks)
 void destroyList( LIST *pList);
     
 
-// Inserts data into list
+// Inserts word into list
+// 새 단어만 아레나에 복사하고, 이미 저장된 단어는 메모리 할당 없이 빈도만 증가
 // return    0 if overflow
 //            1 if successful
 //            2 if duplicated key (이미 저장된 단어는 빈도 증가)
-int addNode( LIST *pList, tWord *dataInPtr);
+int addNode( LIST *pList, char *word);
+
+// Inserts a batch of words into list
+// batch 를 단어순으로 정렬해서 같은 단어를 하나로 모은 뒤, 리스트와 한 번에 병합 (O(count + n log n))
+// 같은 단어의 개수는 빈도에 한 번에 더함
+//    batch    검색용 키 구조체(set_key) 에 대한 pointer n 개 (정렬되어 순서가 바뀜)
+// return    0 if overflow
+//            1 if successful
+int addNodes( LIST *pList, tWord **batch, int n);
 
 // Removes data from list
 //    return    0 not found
@@ -76,6 +92,10 @@ void traverseList( LIST *pList, void (*callback)(const tWord *));
 // traverses data from list (backward)
 void traverseListR( LIST *pList, void (*callback)(const tWord *));
 
+// traverses data from list by frequency (빈도 내림차순, 같은 빈도는 단어순)
+// 마지막 출력 이후 순서가 흐트러진 bucket 만 정렬
+void traverseListByFreq( LIST *pList, void (*callback)(const tWord *));
+
 // internal insert function
 // inserts data into list
 // for addNode function
@@ -95,15 +115,124 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr);
 //             0 not found
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu);
 
+// internal function
+// for addNodes function
+// qsort 로 batch (tWord * 배열) 를 정렬하기 위한 비교 함수
+static int _compare_key( const void *p1, const void *p2);
+
 ////////////////////////////////////////////////////////////////////////////////
-// 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화// return    word structure pointer
+// internal function
+// 단어 구조체와 단어 문자열을 아레나에 할당하고 word, freq 초기화 (common/word.h 의 initWord)
+// word 는 len 바이트 ('\0' 으로 끝나지 않는 mmap 된 단어도 됨)
 // return    할당된 단어 구조체에 대한 pointer
 //            NULL if overflow
-tWord *createWord( char *word);
+static tWord *_create_word( LIST *pList, const char *word, size_t len);
 
-//  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
-void destroyWord( tWord *pNode);
+////////////////////////////////////////////////////////////////////////////////
+// 단어 파일 읽기 (TOKENIZER 는 common/tokenizer.h)
+
+// addNodes 한 번에 넘기는 단어 수
+#define BATCH_SIZE    4096
+
+// pTok 의 남은 단어를 BATCH_SIZE 개씩 모아 addNodes 로 사전에 넣음
+// 키 구조체는 mmap 된 단어를 가리키므로 closeTokenizer 전에 불러야 함
+// return    1 if successful
+//            0 if overflow
+int addTokens( LIST *pList, TOKENIZER *pTok);
+
+// 파일에서 *consumed 바이트 이후에 새로 붙은 단어를 사전에 넣고 *consumed 를 갱신 (-f)
+// 공백으로 끝나지 않은 마지막 단어는 다음 번에 읽음
+// return    새로 읽은 단어 수
+//            -1 if cannot open file or overflow
+//            -2 if 파일이 *consumed 보다 작아짐 (잘림, 사전은 그대로)
+long followFile( LIST *pList, const char *path, size_t *consumed);
+
+////////////////////////////////////////////////////////////////////////////////
+// SNAPSHOT type definition
+// 완성된 사전을 바이너리 파일로 저장 (saveSnapshot) 하고, 다음 실행에서는 파일을 mmap 해서
+// 단어 파일을 다시 읽지 않고 바로 메뉴를 씀 (loadSnapshot)
+// 파일 형식 (version 1, 이 기계의 byte order 그대로):
+//    SNAP_HEADER
+//    uint32_t    offsets[count + 1] // 단어 i 는 blob + offsets[i] 부터 ('\0' 포함), 단어순
+//    int32_t    freq[count]
+//    char    blob[blobSize]
+// 불러올 때 헤더만 확인하고 세 배열은 mmap 한 그대로 가리킴 (파싱 없음, 단어 수와 무관한 시간)
+// 단어 i 의 offsets 는 그 단어를 읽을 때 확인 (offsets[i] < offsets[i + 1] <= blobSize)
+#define SNAP_MAGIC    0x54434457 // "WDCT"
+#define SNAP_VERSION    1
+
+typedef struct{
+    uint32_t    magic; // SNAP_MAGIC (byte order 가 다르면 맞지 않음)
+    uint32_t    version; // SNAP_VERSION
+    uint32_t    count; // 단어 수
+    uint32_t    reserved; // 0
+    uint64_t    blobSize; // 단어 문자열 영역 크기
+} SNAP_HEADER;
+
+typedef struct{
+    void    *map; // mmap 된 파일 전체
+    size_t    size; // 파일 크기
+    int        count; // 단어 수 (삭제한 단어 포함)
+    const uint32_t    *offsets;
+    const int32_t    *freq;
+    const char    *blob;
+    uint64_t    blobSize; // blob 의 크기 (헤더의 blobSize)
+    unsigned char    *deleted; // 메뉴에서 삭제한 단어 표시 (NULL if 없음, 처음 삭제할 때 할당)
+    int        live; // 삭제되지 않은 단어 수
+    int        *byFreq; // 빈도순 단어 index (NULL if 없음, 처음 빈도순 출력할 때 만듦)
+} SNAPSHOT;
+
+// 단어순 리스트를 스냅샷 파일로 저장
+// return    1 if successful
+//            0 if cannot write file or 단어 문자열이 모두 4 GB 를 넘음
+int saveSnapshot( LIST *pList, const char *path);
+
+// 스냅샷 파일을 mmap 해서 읽기 전용 사전을 만듦
+// return    snapshot pointer
+//            NULL if cannot open or map file, or 형식/버전이 다름
+SNAPSHOT *loadSnapshot( const char *path);
+
+// mmap 해제
+void closeSnapshot( SNAPSHOT *pSnap);
+
+// interface to search function (이진 탐색, 단어는 mmap 된 영역을 그대로 가리킴)
+//    pArgu    key being sought
+//    dataOut    찾은 단어를 채울 구조체
+//    return    1 successful
+//            0 not found
+int searchSnapshot( SNAPSHOT *pSnap, tWord *pArgu, tWord *dataOut);
+
+// 스냅샷에서 단어를 지움 (파일은 그대로, 이번 실행에서만 없는 것으로 취급)
+//    dataOut    지운 단어를 채울 구조체
+//    return    0 not found
+//            1 deleted
+int removeSnapshot( SNAPSHOT *pSnap, tWord *keyPtr, tWord *dataOut);
+
+// returns number of words in snapshot (삭제한 단어 제외)
+int countSnapshot( SNAPSHOT *pSnap);
+
+// traverses words from snapshot (forward, backward)
+void traverseSnapshot( SNAPSHOT *pSnap, void (*callback)(const tWord *));
+void traverseSnapshotR( SNAPSHOT *pSnap, void (*callback)(const tWord *));
+
+// traverses words from snapshot by frequency (빈도 내림차순, 같은 빈도는 단어순)
+// return    1 if successful
+//            0 if overflow
+int traverseSnapshotByFreq( SNAPSHOT *pSnap, void (*callback)(const tWord *));
+
+// internal function
+// 스냅샷의 단어 i 의 위치와 길이 (offsets[i] < offsets[i + 1] <= blobSize 이고 '\0' 으로 끝나는지 확인)
+// for _snap_word, _search_snapshot functions
+// return    단어 문자열에 대한 pointer
+//            NULL if offsets 가 잘못됨 (손상된 파일)
+static const char *_snap_span( SNAPSHOT *pSnap, int i, int *len);
+
+// internal function
+// 스냅샷의 단어 i 를 단어 구조체로 (짧은 단어는 복사, 긴 단어는 mmap 된 영역을 가리킴)
+// for searchSnapshot, removeSnapshot, traverseSnapshot functions
+// return    1 if successful
+//            0 if offsets 가 잘못됨
+static int _snap_word( SNAPSHOT *pSnap, int i, tWord *dataOut);
 
 ////////////////////////////////////////////////////////////////////////////////
 // gets user's input
@@ -126,26 +255,17 @@ int get_action(void)
             return DELETE;
         case 'C':
             return COUNT;
+        case 'F':
+            return FREQ_PRINT;
     }
     return 0; // undefined action
 }
 
-// compares two words in word structures
-// for _search function
-// 정렬 기준 : 단어
-int compare_by_word( const void *n1, const void *n2)
-{
-    tWord *p1 = (tWord *)n1;
-    tWord *p2 = (tWord *)n2;
-    
-    return strcmp( p1->word, p2->word);
-}
-
 // prints contents of word structure
 // for traverseList and traverseListR functions
 void print_word(const tWord *dataPtr)
 {
-    printf( "%s\t%d\n", dataPtr->word, dataPtr->freq);
+    printf( "%s\t%d\n", get_word( dataPtr), dataPtr->freq);
 }
 
 // gets user's input
@@ -158,101 +278,155 @@ void input_word(char *word)
 ////////////////////////////////////////////////////////////////////////////////
 int main( int argc, char **argv)
 {
-    LIST *list;
+    LIST *list = NULL;
+    SNAPSHOT *snap = NULL; // -l 이면 리스트 대신 사용
     
     char word[100];
-    tWord *pWord;
+    tWord key; // 검색/삭제용 (긴 단어는 복사하지 않음)
+    tWord found; // 스냅샷에서 찾은 단어
+    TOKENIZER tok;
     int ret;
-    FILE *fp;
-    
-    if (argc != 2){
-        fprintf( stderr, "usage: %s FILE\n", argv[0]);
-        return 1;
-    }
-    
-    fp = fopen( argv[1], "rt");
-    if (!fp)
-    {
-        fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
-        return 2;
-    }
+    const char *follow = NULL; // -f 이면 메뉴를 고를 때마다 파일 뒤에 붙은 단어를 읽음
+    size_t consumed = 0; // follow 파일에서 읽은 바이트 수
     
-    // creates an empty list
-    list = createList();
-    if (!list)
+    if (argc == 3 && strcmp( argv[1], "-l") == 0)
     {
-        printf( "Cannot create list\n");
-        return 100;
+        // 단어 파일을 읽지 않고 저장된 사전을 바로 사용
+        if ((snap = loadSnapshot( argv[2])) == NULL)
+        {
+            fprintf( stderr, "Error: cannot load snapshot [%s]\n", argv[2]);
+            return 2;
+        }
     }
-    
-    while(fscanf( fp, "%s", word) != EOF)
+    else if (argc == 2 || (argc == 4 && strcmp( argv[1], "-s") == 0) || (argc == 3 && strcmp( argv[1], "-f") == 0))
     {
-        pWord = createWord( word);
+        if (argc == 3) follow = argv[2];
+        
+        // -f : 쓰는 중일 수 있는 마지막 단어는 남겨 두고 읽은 위치를 기억
+        if (!openTokenizerAt( &tok, argv[argc - 1], 0, follow == NULL))
+        {
+            fprintf( stderr, "Error: cannot open file [%s]\n", argv[argc - 1]);
+            return 2;
+        }
+        
+        // creates an empty list
+        list = createList();
+        if (!list)
+        {
+            printf( "Cannot create list\n");
+            return 100;
+        }
         
         // 이미 저장된 단어는 빈도 증가
-        ret = addNode( list, pWord);
+        if (!addTokens( list, &tok))
+        {
+            fprintf( stderr, "memory overflow\n");
+        }
         
-        if (ret == 0 || ret == 2) // failure or duplicated
+        if (follow) consumed = tok.offset + tok.size;
+        closeTokenizer( &tok);
+        
+        // -s : 다음 실행에서 -l 로 불러올 수 있도록 저장
+        if (argc == 4 && !saveSnapshot( list, argv[2]))
         {
-            destroyWord( pWord);
+            fprintf( stderr, "Error: cannot save snapshot [%s]\n", argv[2]);
         }
     }
+    else
+    {
+        fprintf( stderr, "usage: %s FILE\n", argv[0]);
+        fprintf( stderr, "       %s -s SNAPSHOT FILE\t(FILE 로 만든 사전을 SNAPSHOT 에 저장)\n", argv[0]);
+        fprintf( stderr, "       %s -l SNAPSHOT\t\t(저장된 사전을 불러옴)\n", argv[0]);
+        fprintf( stderr, "       %s -f FILE\t\t(메뉴를 고를 때마다 FILE 뒤에 새로 붙은 단어를 이어서 읽음)\n", argv[0]);
+        return 1;
+    }
     
-    fclose( fp);
-    
-    fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
+    fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, F)requency print, S)earch, D)elete, C)ount: ");
     
     while (1)
     {
         tWord *ptr;
         int action = get_action();
         
+        // 고른 메뉴를 실행하기 전에 그동안 파일 뒤에 붙은 단어를 사전에 넣음
+        if (follow && action && action != QUIT)
+        {
+            long added = followFile( list, follow, &consumed);
+            
+            if (added > 0) fprintf( stderr, "[%s: +%ld words, %zu bytes]\n", follow, added, consumed);
+            else if (added == -1) fprintf( stderr, "Error: cannot read file [%s]\n", follow);
+            else if (added == -2) fprintf( stderr, "Warning: [%s] was truncated, not reloaded\n", follow);
+        }
+        
         switch( action)
         {
             case QUIT:
-                destroyList( list);
+                if (snap) closeSnapshot( snap);
+                else destroyList( list);
                 return 0;
             
             case FORWARD_PRINT:
-                traverseList( list, print_word);
+                if (snap) traverseSnapshot( snap, print_word);
+                else traverseList( list, print_word);
                 break;
             
             case BACKWARD_PRINT:
-                traverseListR( list, print_word);
+                if (snap) traverseSnapshotR( snap, print_word);
+                else traverseListR( list, print_word);
                 break;
             
             case SEARCH:
                 input_word(word);
                 
-                pWord = createWord( word);
+                set_key( &key, word);
+                
+                if (snap)
+                {
+                    ptr = &found;
+                    ret = searchSnapshot( snap, &key, ptr);
+                }
+                else ret = searchNode( list, &key, &ptr);
 
-                if (searchNode( list, pWord, &ptr)) print_word( ptr);
+                if (ret) print_word( ptr);
                 else fprintf( stdout, "%s not found\n", word);
                 
-                destroyWord( pWord);
                 break;
                 
             case DELETE:
                 input_word(word);
                 
-                pWord = createWord( word);
+                set_key( &key, word);
+                
+                // 삭제된 단어의 메모리는 destroyList 에서 아레나와 함께 해제
+                if (snap)
+                {
+                    ptr = &found;
+                    ret = removeSnapshot( snap, &key, ptr);
+                }
+                else ret = removeNode( list, &key, &ptr);
 
-                if (removeNode( list, pWord, &ptr))
+                if (ret)
                 {
-                    fprintf( stdout, "%s\t%d deleted\n", ptr->word, ptr->freq);
-                    destroyWord( ptr);
+                    fprintf( stdout, "%s\t%d deleted\n", get_word( ptr), ptr->freq);
                 }
                 else fprintf( stdout, "%s not found\n", word);
                 
-                destroyWord( pWord);
+                break;
+            
+            case FREQ_PRINT:
+                if (snap)
+                {
+                    if (!traverseSnapshotByFreq( snap, print_word)) fprintf( stderr, "memory overflow\n");
+                }
+                else traverseListByFreq( list, print_word);
                 break;
             
             case COUNT:
-                fprintf( stdout, "%d\n", countList( list));
+                fprintf( stdout, "%d\n", snap ? countSnapshot( snap) : countList( list));
                 break;
         }
         
-        if (action) fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
+        if (action) fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, F)requency print, S)earch, D)elete, C)ount: ");
     }
     return 0;
 }
@@ -265,43 +439,48 @@ LIST *createList(void){
     pList -> count = 0;
     pList -> head = NULL;
     pList -> rear = NULL;
+    pList -> arena = NULL;
+    pList -> freeNodes = NULL;
+    initFreqIndex(&pList -> index);
     
     return pList;
 }
 
-//  단어 리스트에 할당된 메모리를 해제 (head node, data node, word data)
+//  단어 리스트에 할당된 메모리를 해제 (head node, arena blocks)
+// 노드와 단어는 모두 아레나에 있으므로 블록만 해제
 void destroyList( LIST *pList){
-    NODE *cur = pList -> head;
-    
-    while(cur){
-        
-        NODE *next = cur -> rlink;
-        destroyWord(cur -> dataPtr);
-        free(cur);
-        cur =  next;
-    }
-    
+    destroyArena(pList -> arena);
     free(pList);
-    
 }
     
-// Inserts data into list
+// Inserts word into list
+// 새 단어만 아레나에 복사하고, 이미 저장된 단어는 메모리 할당 없이 빈도만 증가
 // return    0 if overflow
 //            1 if successful
 //            2 if duplicated key (이미 저장된 단어는 빈도 증가)
-int addNode(LIST *pList, tWord *dataInPtr) {
+int addNode(LIST *pList, char *word) {
     NODE *pPre = NULL;
     NODE *pLoc = NULL;
+    tWord key; // 검색용 (긴 단어는 복사하지 않음)
 
-    int found = _search(pList, &pPre, &pLoc, dataInPtr);
+    set_key(&key, word);
+    int found = _search(pList, &pPre, &pLoc, &key);
 
     if (found) {
-        pLoc->dataPtr->freq++;
+        // 빈도를 늘리고 바로 위 빈도 bucket 으로 옮김
+        if (!incFreqNode(&pList -> index, &pList -> arena, &pLoc -> fnode, 1)) {
+            return 0;
+        }
         
         return 2;
     }
 
     // 중복 아니면 삽입 시도
+    tWord *dataInPtr = _create_word(pList, word, key.len);
+    if (dataInPtr == NULL) {
+        return 0;
+    }
+    
     if (!(_insert(pList, pPre, dataInPtr))) {
         return 0;
     }
@@ -310,6 +489,50 @@ int addNode(LIST *pList, tWord *dataInPtr) {
     return 1;
 }
 
+// Inserts a batch of words into list
+// batch 를 단어순으로 정렬해서 같은 단어를 하나로 모은 뒤, 리스트와 한 번에 병합
+// 키가 정렬되어 있으므로 리스트는 처음부터 끝까지 한 번만 훑음 (키마다 head 부터 검색하지 않음)
+int addNodes( LIST *pList, tWord **batch, int n){
+    NODE *pPre = NULL;
+    NODE *pLoc = pList -> head;
+    
+    qsort(batch, n, sizeof(tWord *), _compare_key);
+    
+    for(int i = 0; i < n; ){
+        tWord *key = batch[i];
+        int count = 1;
+        int cmp = 1;
+        
+        // 같은 단어는 하나로 모아 개수만 셈
+        while(i + count < n && compare_by_word(batch[i + count], key) == 0){
+            count++;
+        }
+        i += count;
+        
+        // 앞의 키보다 뒤에 있으므로 지난번 위치부터 계속 검색
+        while(pLoc != NULL && (cmp = compare_by_word(pLoc -> fnode.dataPtr, key)) < 0){
+            pPre = pLoc;
+            pLoc = pLoc -> rlink;
+        }
+        
+        if(pLoc != NULL && cmp == 0){
+            if(!incFreqNode(&pList -> index, &pList -> arena, &pLoc -> fnode, count)) return 0;
+            continue;
+        }
+        
+        tWord *pWord = _create_word(pList, get_word(key), key -> len);
+        if(pWord == NULL) return 0;
+        
+        pWord -> freq = count;
+        if(!_insert(pList, pPre, pWord)) return 0;
+        pList -> count++;
+        
+        // 새 노드 다음부터 계속
+        pPre = pPre != NULL ? pPre -> rlink : pList -> head;
+    }
+    return 1;
+}
+
 
 // Removes data from list
 //    return    0 not found
@@ -340,7 +563,7 @@ int searchNode( LIST *pList, tWord *pArgu, tWord **dataOutPtr){
     int found = _search(pList, &pPre, &pLoc, pArgu);
     
     if(found){
-        *dataOutPtr = pLoc -> dataPtr;
+        *dataOutPtr = pLoc -> fnode.dataPtr;
     }
     
     return found;
@@ -373,7 +596,7 @@ void traverseList( LIST *pList, void (*callback)(const tWord *)){
     NODE *cur = pList -> head;
     
     while(cur){
-        callback(cur -> dataPtr);
+        callback(cur -> fnode.dataPtr);
         cur = cur -> rlink;
     }
 }
@@ -384,11 +607,25 @@ void traverseListR( LIST *pList, void (*callback)(const tWord *)){
     NODE *cur = pList -> rear;
     
     while(cur){
-        callback(cur -> dataPtr);
+        callback(cur -> fnode.dataPtr);
         cur = cur -> llink;
     }
 }
 
+// traverses data from list by frequency
+// 빈도 bucket 은 단어가 들어올 때마다 갱신되므로 빈도가 큰 bucket 부터 그대로 훑음
+// 같은 빈도 안의 단어순은 마지막 출력 이후 새 단어가 붙은 bucket 만 다시 정렬
+void traverseListByFreq( LIST *pList, void (*callback)(const tWord *)){
+    
+    for(BUCKET *pBucket = pList -> index.top; pBucket != NULL; pBucket = pBucket -> down){
+        sortBucket(pBucket);
+        
+        for(FNODE *cur = pBucket -> first; cur != NULL; cur = cur -> link2){
+            callback(cur -> dataPtr);
+        }
+    }
+}
+
 // internal insert function
 // inserts data into list
 // for addNode function
@@ -396,14 +633,28 @@ void traverseListR( LIST *pList, void (*callback)(const tWord *)){
 //             0 if memory overflow
 static int _insert( LIST *pList, NODE *pPre, tWord *dataInPtr){
     
-    NODE *newNode = malloc(sizeof(NODE));
-    if(newNode == NULL) return 0;
+    NODE *newNode = pList -> freeNodes;
+    
+    if(newNode != NULL){
+        pList -> freeNodes = newNode -> rlink;
+    }
+    else{
+        newNode = arenaAlloc(&pList -> arena, sizeof(NODE));
+        if(newNode == NULL) return 0;
+    }
     
     
-    newNode -> dataPtr = dataInPtr;
+    newNode -> fnode.dataPtr = dataInPtr;
     newNode -> llink = NULL;
     newNode -> rlink = NULL;
     
+    // 빈도 bucket 에 넣지 못하면 노드를 재사용 리스트로 돌려줌
+    if(!addFreqNode(&pList -> index, &pList -> arena, &newNode -> fnode)){
+        newNode -> rlink = pList -> freeNodes;
+        pList -> freeNodes = newNode;
+        return 0;
+    }
+    
     if(pPre == NULL){
         newNode -> rlink = pList -> head;
         
@@ -435,12 +686,20 @@ static int _insert( LIST *pList, NODE *pPre, tWord *dataInPtr){
     }
 }
 
+// 삭제된 노드를 재사용 리스트에 넣음 (아레나 메모리는 개별 해제하지 않음)
+// for _delete function
+static void _free_node( LIST *pList, NODE *pLoc){
+    pLoc -> rlink = pList -> freeNodes;
+    pList -> freeNodes = pLoc;
+}
+
 // internal delete function
 // deletes data from list and saves the (deleted) data to dataOutPtr
 // for removeNode function
 static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr){
     
-    *dataOutPtr = pLoc -> dataPtr;
+    *dataOutPtr = pLoc -> fnode.dataPtr;
+    removeFreqNode(&pList -> index, &pLoc -> fnode);
     
     if(pPre == NULL){  // a <-> b <-> c    a 삭제할거임
        
@@ -453,7 +712,7 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr){
             pList -> rear = NULL;
         }
         
-        free(pLoc);
+        _free_node(pList, pLoc);
     }
     
     else{
@@ -461,15 +720,15 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr){
             pPre -> rlink = NULL;
             pList -> rear = pPre;
             
-            free(pLoc);
+            _free_node(pList, pLoc);
         }
         
-        if(pPre != NULL && pLoc -> rlink != NULL){// 중간 단어.  a <-> b <-> c   b를 제거할거임
+        else if(pPre != NULL && pLoc -> rlink != NULL){// 중간 단어.  a <-> b <-> c   b를 제거할거임
             
             pPre -> rlink = pLoc -> rlink; // ->
             pLoc -> rlink -> llink = pPre; // <-
             
-            free(pLoc);
+            _free_node(pList, pLoc);
             
         }
     }
@@ -485,47 +744,371 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu){
     *pPre = NULL;
     *pLoc = pList -> head;
     
-    while(*pLoc != NULL && compare_by_word((*pLoc) -> dataPtr, pArgu) < 0){
+    while(*pLoc != NULL && compare_by_word((*pLoc) -> fnode.dataPtr, pArgu) < 0){
         *pPre = *pLoc;
         *pLoc = (*pLoc) -> rlink;
     }
     
-    if(*pLoc != NULL && compare_by_word((*pLoc) -> dataPtr, pArgu) == 0){
+    if(*pLoc != NULL && compare_by_word((*pLoc) -> fnode.dataPtr, pArgu) == 0){
         return 1;
     }
     
     return 0;
 }
 
+// internal function
+// for addNodes function
+// qsort 로 batch (tWord * 배열) 를 정렬하기 위한 비교 함수
+static int _compare_key( const void *p1, const void *p2){
+    return compare_by_word(*(tWord * const *)p1, *(tWord * const *)p2);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-// 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화// return    word structure pointer
+// internal function
+// 단어 구조체와 단어 문자열을 아레나에 할당하고 word, freq 초기화 (common/word.h 의 initWord)
+// word 는 len 바이트 ('\0' 으로 끝나지 않는 mmap 된 단어도 됨)
 // return    할당된 단어 구조체에 대한 pointer
 //            NULL if overflow
+static tWord *_create_word( LIST *pList, const char *word, size_t len){
+    // 긴 단어만 문자열을 구조체 바로 뒤에 저장
+    void *pWord = arenaAlloc(&pList -> arena, word_size(len));
+    if(pWord == NULL) return NULL;
+    
+    return initWord(pWord, word, len);
+}
 
+////////////////////////////////////////////////////////////////////////////////
+// 단어 파일 읽기
 
-tWord *createWord( char *word){
-    tWord *pWord = malloc(sizeof(tWord));
-    if(pWord == NULL) return NULL;
+// pTok 의 남은 단어를 BATCH_SIZE 개씩 모아 addNodes 로 사전에 넣음
+// return    1 if successful
+//            0 if overflow
+int addTokens( LIST *pList, TOKENIZER *pTok){
+    tWord *keys = malloc(sizeof(tWord) * BATCH_SIZE);
+    tWord **batch = malloc(sizeof(tWord *) * BATCH_SIZE);
+    const char *word;
+    size_t len;
+    int n = 0;
+    int ret = keys != NULL && batch != NULL;
+    
+    while(ret && nextToken(pTok, &word, &len)){
+        set_key_len(&keys[n], word, len);
+        batch[n] = &keys[n];
+        
+        if(++n == BATCH_SIZE){
+            ret = addNodes(pList, batch, n);
+            n = 0;
+        }
+    }
+    if(ret && n > 0){
+        ret = addNodes(pList, batch, n);
+    }
+    
+    free(keys);
+    free(batch);
+    return ret;
+}
+
+// 파일에서 *consumed 바이트 이후에 새로 붙은 단어를 사전에 넣고 *consumed 를 갱신
+// 이미 읽은 부분은 다시 매핑하지도 훑지도 않음 (새로 붙은 바이트 수에 비례)
+// return    새로 읽은 단어 수
+//            -1 if cannot open file or overflow
+//            -2 if 파일이 *consumed 보다 작아짐
+long followFile( LIST *pList, const char *path, size_t *consumed){
+    TOKENIZER tok;
+    struct stat st;
+    
+    if(stat(path, &st) < 0) return -1;
+    if((size_t)st.st_size < *consumed) return -2;
+    if((size_t)st.st_size == *consumed) return 0;
+    
+    if(!openTokenizerAt(&tok, path, *consumed, 0)) return -1;
+    
+    long words = 0;
+    
+    // 새 단어 수는 빈도 합의 증가량으로 셈 (addNodes 는 같은 단어를 하나로 모음, bucket 수만큼만 훑음)
+    for(BUCKET *pBucket = pList -> index.top; pBucket != NULL; pBucket = pBucket -> down){
+        words -= (long)pBucket -> freq * pBucket -> count;
+    }
+    
+    int ok = addTokens(pList, &tok);
+    
+    for(BUCKET *pBucket = pList -> index.top; pBucket != NULL; pBucket = pBucket -> down){
+        words += (long)pBucket -> freq * pBucket -> count;
+    }
+    
+    // 공백이 뒤따르는 단어까지만 읽었으므로 다음에는 그 다음 바이트부터
+    if(ok) *consumed = tok.offset + tok.size;
+    closeTokenizer(&tok);
+    
+    return ok ? words : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// snapshot
+
+// 단어순 리스트를 스냅샷 파일로 저장
+// 리스트를 세 번 훑으며 offsets, freq, blob 순서로 씀
+// offsets 가 uint32_t 이므로 단어 문자열이 모두 4 GB 를 넘으면 저장하지 않음 (파일도 만들지 않음)
+// return    1 if successful
+//            0 if cannot write file or blob 이 4 GB 를 넘음
+int saveSnapshot( LIST *pList, const char *path){
+    SNAP_HEADER header = { SNAP_MAGIC, SNAP_VERSION, 0, 0, 0 };
+    
+    header.count = (uint32_t)pList -> count;
+    for(NODE *cur = pList -> head; cur != NULL; cur = cur -> rlink){
+        header.blobSize += cur -> fnode.dataPtr -> len + 1;
+    }
+    if(header.blobSize > UINT32_MAX) return 0;
+    
+    FILE *fp = fopen(path, "wb");
+    if(fp == NULL) return 0;
+    
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    uint32_t offset = 0;
+    
+    for(NODE *cur = pList -> head; ok && cur != NULL; cur = cur -> rlink){
+        ok = fwrite(&offset, sizeof(offset), 1, fp) == 1;
+        offset += cur -> fnode.dataPtr -> len + 1;
+    }
+    ok = ok && fwrite(&offset, sizeof(offset), 1, fp) == 1;
+    
+    for(NODE *cur = pList -> head; ok && cur != NULL; cur = cur -> rlink){
+        int32_t freq = cur -> fnode.dataPtr -> freq;
+        ok = fwrite(&freq, sizeof(freq), 1, fp) == 1;
+    }
+    
+    for(NODE *cur = pList -> head; ok && cur != NULL; cur = cur -> rlink){
+        ok = fwrite(get_word(cur -> fnode.dataPtr), cur -> fnode.dataPtr -> len + 1, 1, fp) == 1;
+    }
+    
+    if(fclose(fp) != 0) ok = 0;
+    return ok;
+}
+
+// 스냅샷 파일을 mmap 해서 읽기 전용 사전을 만듦
+// 헤더의 magic, version, 파일 크기와 offsets 의 처음/마지막 값만 확인 (단어 수와 무관한 시간)
+// 단어마다의 offsets 는 검색/출력에서 그 단어를 읽을 때 _snap_span 이 확인하므로 mmap 영역 밖을 읽지 않음
+// return    snapshot pointer
+//            NULL if cannot open or map file, or 형식/버전이 다름
+SNAPSHOT *loadSnapshot( const char *path){
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return NULL;
+    
+    if(fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(SNAP_HEADER)){
+        close(fd);
+        return NULL;
+    }
+    
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) return NULL;
+    
+    const SNAP_HEADER *header = map;
+    uint64_t expected = sizeof(SNAP_HEADER) + ((uint64_t)header -> count + 1) * sizeof(uint32_t)
+        + (uint64_t)header -> count * sizeof(int32_t) + header -> blobSize;
+    SNAPSHOT *pSnap = malloc(sizeof(SNAPSHOT));
+    
+    if(pSnap == NULL || header -> magic != SNAP_MAGIC || header -> version != SNAP_VERSION
+        || header -> count > INT32_MAX - 1 || expected != (uint64_t)st.st_size){
+        free(pSnap);
+        munmap(map, (size_t)st.st_size);
+        return NULL;
+    }
     
-    pWord -> word = strdup(word);
+    pSnap -> map = map;
+    pSnap -> size = (size_t)st.st_size;
+    pSnap -> count = (int)header -> count;
+    pSnap -> offsets = (const uint32_t *)(header + 1);
+    pSnap -> freq = (const int32_t *)(pSnap -> offsets + pSnap -> count + 1);
+    pSnap -> blob = (const char *)(pSnap -> freq + pSnap -> count);
+    pSnap -> blobSize = header -> blobSize;
+    pSnap -> deleted = NULL;
+    pSnap -> live = pSnap -> count;
+    pSnap -> byFreq = NULL;
     
-    if(pWord -> word == NULL){
-        free(pWord);
+    // 마지막 offset 은 blob 의 끝 (나머지 offsets 는 단어를 읽을 때 _snap_span 에서 확인)
+    int ok = pSnap -> offsets[0] == 0 && pSnap -> offsets[pSnap -> count] == header -> blobSize
+        && (header -> blobSize == 0 || pSnap -> blob[header -> blobSize - 1] == '\0');
+    
+    if(!ok){
+        closeSnapshot(pSnap);
         return NULL;
     }
+    return pSnap;
+}
+
+// mmap 해제
+void closeSnapshot( SNAPSHOT *pSnap){
+    munmap(pSnap -> map, pSnap -> size);
+    free(pSnap -> deleted);
+    free(pSnap -> byFreq);
+    free(pSnap);
+}
+
+// internal function
+// 스냅샷의 단어 i 의 위치와 길이 (loadSnapshot 은 offsets 를 모두 읽지 않으므로 여기서 확인)
+static const char *_snap_span( SNAPSHOT *pSnap, int i, int *len){
+    uint32_t from = pSnap -> offsets[i];
+    uint32_t to = pSnap -> offsets[i + 1];
     
-    pWord -> freq = 1;
+    if(from >= to || to > pSnap -> blobSize || pSnap -> blob[to - 1] != '\0') return NULL;
     
-    return pWord;
+    *len = (int)(to - from) - 1;
+    return pSnap -> blob + from;
+}
+
+// internal function
+// 스냅샷의 단어 i 를 단어 구조체로 (짧은 단어는 복사, 긴 단어는 mmap 된 영역을 가리킴)
+static int _snap_word( SNAPSHOT *pSnap, int i, tWord *dataOut){
+    int len;
+    const char *word = _snap_span(pSnap, i, &len);
+    if(word == NULL) return 0;
     
+    dataOut -> freq = pSnap -> freq[i];
+    dataOut -> len = len;
+    if(len < WORD_INLINE){
+        memcpy(dataOut -> word.str, word, len + 1);
+    }
+    else{
+        dataOut -> word.ptr = (char *)word;
+    }
+    return 1;
 }
 
-//  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
-void destroyWord( tWord *pNode){
-    if(pNode == NULL) return;
+// internal search function
+// 단어순으로 저장된 단어들을 이진 탐색
+// for searchSnapshot, removeSnapshot functions
+// return    단어의 index
+//            -1 not found (삭제한 단어, 손상된 offsets 포함)
+static int _search_snapshot( SNAPSHOT *pSnap, tWord *pArgu){
+    const char *key = get_word(pArgu);
+    int lo = 0;
+    int hi = pSnap -> count - 1;
     
-    free(pNode -> word);
-    free(pNode);
+    while(lo <= hi){
+        int mid = lo + (hi - lo) / 2;
+        int len;
+        const char *word = _snap_span(pSnap, mid, &len);
+        if(word == NULL) return -1; // 손상된 offsets: 더 찾지 않음
+        
+        // compare_by_word 와 같은 순서: 공통 부분이 같으면 짧은 단어가 앞
+        int ret = memcmp(key, word, pArgu -> len < len ? pArgu -> len : len);
+        if(ret == 0) ret = pArgu -> len - len;
+        
+        if(ret == 0){
+            if(pSnap -> deleted != NULL && pSnap -> deleted[mid]) return -1;
+            return mid;
+        }
+        if(ret < 0) hi = mid - 1;
+        else lo = mid + 1;
+    }
+    return -1;
+}
+
+// interface to search function
+//    return    1 successful
+//            0 not found
+int searchSnapshot( SNAPSHOT *pSnap, tWord *pArgu, tWord *dataOut){
+    int i = _search_snapshot(pSnap, pArgu);
+    if(i < 0) return 0;
+    
+    return _snap_word(pSnap, i, dataOut);
 }
 
+// 스냅샷에서 단어를 지움 (파일은 그대로, 이번 실행에서만 없는 것으로 취급)
+//    return    0 not found
+//            1 deleted
+int removeSnapshot( SNAPSHOT *pSnap, tWord *keyPtr, tWord *dataOut){
+    int i = _search_snapshot(pSnap, keyPtr);
+    if(i < 0) return 0;
+    
+    if(pSnap -> deleted == NULL){
+        pSnap -> deleted = calloc(pSnap -> count, 1);
+        if(pSnap -> deleted == NULL) return 0;
+    }
+    pSnap -> deleted[i] = 1;
+    pSnap -> live--;
+    
+    _snap_word(pSnap, i, dataOut);
+    return 1;
+}
+
+// returns number of words in snapshot (삭제한 단어 제외)
+int countSnapshot( SNAPSHOT *pSnap){
+    return pSnap -> live;
+}
+
+// traverses words from snapshot (forward)
+void traverseSnapshot( SNAPSHOT *pSnap, void (*callback)(const tWord *)){
+    tWord data;
+    
+    for(int i = 0; i < pSnap -> count; i++){
+        if(pSnap -> deleted != NULL && pSnap -> deleted[i]) continue;
+        
+        if(_snap_word(pSnap, i, &data)) callback(&data);
+    }
+}
+
+// traverses words from snapshot (backward)
+void traverseSnapshotR( SNAPSHOT *pSnap, void (*callback)(const tWord *)){
+    tWord data;
+    
+    for(int i = pSnap -> count - 1; i >= 0; i--){
+        if(pSnap -> deleted != NULL && pSnap -> deleted[i]) continue;
+        
+        if(_snap_word(pSnap, i, &data)) callback(&data);
+    }
+}
+
+// traverses words from snapshot by frequency
+// 처음 부를 때 단어 index 를 빈도 내림차순으로 안정 정렬해 두고 (같은 빈도는 index 순 = 단어순) 이후에는 그대로 사용
+// return    1 if successful
+//            0 if overflow
+int traverseSnapshotByFreq( SNAPSHOT *pSnap, void (*callback)(const tWord *)){
+    tWord data;
+    
+    if(pSnap -> byFreq == NULL && pSnap -> count > 0){
+        int *a = malloc(sizeof(int) * pSnap -> count);
+        int *tmp = malloc(sizeof(int) * pSnap -> count);
+        
+        if(a == NULL || tmp == NULL){
+            free(a);
+            free(tmp);
+            return 0;
+        }
+        for(int i = 0; i < pSnap -> count; i++){
+            a[i] = i;
+        }
+        
+        // bottom-up merge sort (재귀 없음), 같은 빈도는 앞쪽 run 을 먼저
+        for(int width = 1; width < pSnap -> count; width *= 2){
+            for(int lo = 0; lo < pSnap -> count; lo += 2 * width){
+                int mid = lo + width < pSnap -> count ? lo + width : pSnap -> count;
+                int hi = mid + width < pSnap -> count ? mid + width : pSnap -> count;
+                int i = lo, j = mid, k = lo;
+                
+                while(i < mid && j < hi){
+                    if(pSnap -> freq[a[j]] > pSnap -> freq[a[i]]) tmp[k++] = a[j++];
+                    else tmp[k++] = a[i++];
+                }
+                while(i < mid) tmp[k++] = a[i++];
+                while(j < hi) tmp[k++] = a[j++];
+            }
+            int *t = a;
+            a = tmp;
+            tmp = t;
+        }
+        free(tmp);
+        pSnap -> byFreq = a;
+    }
+    
+    for(int i = 0; i < pSnap -> count; i++){
+        int w = pSnap -> byFreq[i];
+        if(pSnap -> deleted != NULL && pSnap -> deleted[w]) continue;
+        
+        if(_snap_word(pSnap, w, &data)) callback(&data);
+    }
+    return 1;
+}
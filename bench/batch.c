@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc
+#include <string.h> // memcmp, memcpy, strtol
+#include <time.h>   // clock_gettime
+
+// assignment_2 사전 만들기: 토큰마다 addNode 와 batch 개씩 addNodes 비교
+// (헤더가 없는 프로그램이므로 main.c 를 그대로 포함, 단어 비교는 common/word.c 와 함께 포함해서 memcmp 에서 셈)
+// usage: bench_batch [FILE [B,B,...]]
+//	FILE	단어 파일 (default ../assignment04/words.txt)
+//	B		batch 크기 목록 (default 1,16,256,4096,65536)
+//	출력: batch, 토큰 수, 단어 수, 입력 시간, 토큰당 비교 횟수
+long cmpCount;
+
+#define main	mlist_main
+#define memcmp( s1, s2, n)	(cmpCount++, memcmp( s1, s2, n))
+#include "../common/word.c"
+#include "../assignment_2/assignment02.p/main.c"
+#undef memcmp
+#undef main
+
+////////////////////////////////////////////////////////////////////////////////
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// nextToken 의 단어는 '\0' 으로 끝나지 않으므로 복사해서 addNode 에 넘김
+// return	addNode 의 반환값 (0 if overflow)
+static int add_token( LIST *list, const char *word, size_t len)
+{
+	static char *buf;
+	static size_t size;
+
+	if (len + 1 > size)
+	{
+		char *p = realloc( buf, len + 1);
+		if (p == NULL)
+			return 0;
+		buf = p;
+		size = len + 1;
+	}
+	memcpy( buf, word, len);
+	buf[len] = '\0';
+	return addNode( list, buf);
+}
+
+// batch 가 0 이면 토큰마다 addNode, 아니면 batch 개씩 addNodes
+// return	만든 사전 (NULL if overflow)
+static LIST *run( const char *path, int batch, long *ntokens, double *ms)
+{
+	LIST *list = createList();
+	tWord *keys = malloc( sizeof(tWord) * (batch > 0 ? batch : 1));
+	tWord **ptrs = malloc( sizeof(tWord *) * (batch > 0 ? batch : 1));
+	TOKENIZER tok;
+	const char *word;
+	size_t len;
+	double t0;
+	int n = 0, ok = 1;
+
+	*ntokens = 0;
+	if (list == NULL || keys == NULL || ptrs == NULL || !openTokenizer( &tok, path))
+		return NULL;
+
+	cmpCount = 0;
+	t0 = now_ms();
+	while (ok && nextToken( &tok, &word, &len))
+	{
+		(*ntokens)++;
+		if (batch == 0)
+		{
+			ok = add_token( list, word, len) != 0;
+			continue;
+		}
+		set_key_len( &keys[n], word, len);
+		ptrs[n] = &keys[n];
+		if (++n == batch)
+		{
+			ok = addNodes( list, ptrs, n);
+			n = 0;
+		}
+	}
+	if (ok && n > 0)
+		ok = addNodes( list, ptrs, n);
+	*ms = now_ms() - t0;
+
+	closeTokenizer( &tok);
+	free( keys);
+	free( ptrs);
+	if (!ok)
+	{
+		destroyList( list);
+		return NULL;
+	}
+	return list;
+}
+
+// 두 사전의 단어와 빈도가 같은지 확인
+static int same( LIST *a, LIST *b)
+{
+	NODE *p = a->head, *q = b->head;
+
+	for (; p != NULL && q != NULL; p = p->link, q = q->link)
+		if (compare_by_word( p->fnode.dataPtr, q->fnode.dataPtr) != 0 || p->fnode.dataPtr->freq != q->fnode.dataPtr->freq)
+			return 0;
+	return p == NULL && q == NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "../assignment04/words.txt";
+	int sizes[16] = { 1, 16, 256, 4096, 65536 };
+	int nsizes = 5;
+	LIST *ref, *list;
+	long ntokens;
+	double ms;
+	int i, bad = 0;
+
+	if (argc > 2)
+	{
+		char *p = argv[2];
+
+		for (nsizes = 0; *p && nsizes < 16; nsizes++)
+		{
+			sizes[nsizes] = (int)strtol( p, &p, 10);
+			if (*p == ',')
+				p++;
+		}
+	}
+
+	if ((ref = run( path, 0, &ntokens, &ms)) == NULL)
+	{
+		fprintf( stderr, "cannot read file : %s\n", path);
+		return 2;
+	}
+	printf( "%-8s %9s %9s %12s %12s\n", "batch", "tokens", "words", "ms", "cmp/token");
+	printf( "%-8s %9ld %9d %12.1f %12.1f\n", "addNode", ntokens, ref->count, ms, (double)cmpCount / ntokens);
+
+	for (i = 0; i < nsizes; i++)
+	{
+		if (sizes[i] < 1 || (list = run( path, sizes[i], &ntokens, &ms)) == NULL)
+		{
+			fprintf( stderr, "batch %d : failed\n", sizes[i]);
+			return 1;
+		}
+		printf( "%-8d %9ld %9d %12.1f %12.1f\n", sizes[i], ntokens, list->count, ms, (double)cmpCount / ntokens);
+		if (!same( ref, list))
+		{
+			fprintf( stderr, "batch %d : dictionary differs from addNode\n", sizes[i]);
+			bad = 1;
+		}
+		destroyList( list);
+	}
+	destroyList( ref);
+	return bad;
+}
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, atoi
+#include <string.h> // strcmp, strdup
+#include <unistd.h> // fork
+#include <time.h>   // clock_gettime
+#include <sys/wait.h> // waitpid
+#include <sys/resource.h> // getrusage
+
+#include "dict.h"
+
+// 사전 구현 간 비교 벤치마크 (CSV 출력)
+// dict_mlist.c / dict_dlist.c / dict_bst.c 중 하나와 링크해 bench_mlist, bench_dlist, bench_bst 를 만듦
+// usage: bench_xxx [-H] [-n N,N,...] [-q MAX] [-w FILE]
+//	-H		CSV 헤더를 출력하지 않음 (여러 결과를 이어 붙일 때)
+//	-n		합성 입력 크기 목록 (default 1000,10000,100000)
+//	-q		연산당 O(n) 인 구조/입력 조합을 돌릴 최대 크기 (default 10000)
+//	-w		단어 파일 (default ../assignment04/words.txt)
+//
+// workloads (timed phase 만 측정)
+//	words		단어 파일의 토큰을 순서대로 insert (중복 포함)
+//	sorted		서로 다른 키 n개를 오름차순 insert
+//	reverse		서로 다른 키 n개를 내림차순 insert
+//	zipf		어휘 n/10 개에서 Zipf(s=1) 분포로 뽑은 토큰 n개를 insert
+//	search-hit	무작위 순서로 n개 insert 후, 다른 무작위 순서로 n개 모두 search
+//	search-miss	같은 구조에서 없는 키 n개를 search (기존 키 사이에 끼는 키)
+//	delete-heavy	무작위 순서로 n개 insert 후, 모두 remove 하면서 절반은 다시 insert
+//
+// columns: structure,workload,n,ops,ns_per_op,cmp_per_op,peak_rss_kb
+//	peak_rss_kb 는 실행마다 fork 한 자식 프로세스의 최대 RSS (키 배열 포함)
+
+long cmpCount;
+
+////////////////////////////////////////////////////////////////////////////////
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// xorshift64 (플랫폼에 관계없이 같은 입력을 만들기 위해 rand 대신 사용)
+static unsigned long long rngState = 88172645463325252ULL;
+
+static unsigned long long rng( void)
+{
+	rngState ^= rngState << 13;
+	rngState ^= rngState >> 7;
+	rngState ^= rngState << 17;
+	return rngState;
+}
+
+static void shuffle( char **keys, int n)
+{
+	int i;
+
+	for (i = n - 1; i > 0; i--)
+	{
+		int j = (int)(rng() % (unsigned long long)(i + 1));
+		char *t = keys[i];
+		keys[i] = keys[j];
+		keys[j] = t;
+	}
+}
+
+// "k00000000" ... 형식의 서로 다른 키 n개 (사전순 == 숫자순)
+// suffix 가 있으면 키 뒤에 붙임 (search-miss 용, 기존 키 사이에 위치)
+static char **make_keys( int n, const char *suffix)
+{
+	char **keys = malloc( sizeof(char *) * (n > 0 ? n : 1));
+	char word[32];
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		sprintf( word, "k%08d%s", i, suffix);
+		keys[i] = strdup( word);
+	}
+	return keys;
+}
+
+// 어휘 n/10 개에 대해 rank r 의 확률이 1/r 에 비례하도록 토큰 n개를 뽑음
+static char **make_zipf( int n)
+{
+	int v = n / 10 > 0 ? n / 10 : 1;
+	char **vocab = make_keys( v, "");
+	char **tokens = malloc( sizeof(char *) * (n > 0 ? n : 1));
+	double *cdf = malloc( sizeof(double) * v);
+	double sum = 0;
+	int i;
+
+	shuffle( vocab, v); // rank 와 사전순이 무관하도록
+	for (i = 0; i < v; i++)
+	{
+		sum += 1.0 / (i + 1);
+		cdf[i] = sum;
+	}
+	for (i = 0; i < n; i++)
+	{
+		double u = (rng() >> 11) * (1.0 / 9007199254740992.0) * sum;
+		int lo = 0, hi = v - 1;
+
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (cdf[mid] < u)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		tokens[i] = vocab[lo];
+	}
+	free( cdf);
+	return tokens; // vocab 문자열은 프로세스 종료 시 회수
+}
+
+static char **read_words( const char *path, int *nwords)
+{
+	char **words;
+	char word[100];
+	FILE *fp;
+	int cap = 1024;
+
+	*nwords = 0;
+	if ((fp = fopen( path, "r")) == NULL)
+		return NULL;
+
+	words = malloc( sizeof(char *) * cap);
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (*nwords == cap)
+			words = realloc( words, sizeof(char *) * (cap *= 2));
+		words[(*nwords)++] = strdup( word);
+	}
+	fclose( fp);
+	return words;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+enum { W_WORDS, W_SORTED, W_REVERSE, W_ZIPF, W_HIT, W_MISS, W_DELETE, W_COUNT };
+
+static const char *workloadName[W_COUNT] =
+{
+	"words", "sorted", "reverse", "zipf", "search-hit", "search-miss", "delete-heavy"
+};
+
+// 자식 프로세스에서 한 번 실행하고 CSV 한 줄 출력
+// return	0 if successful
+//			1 if an operation returned an unexpected result
+static int run( DICT_OPS *ops, int w, int n, const char *path)
+{
+	void *dict = ops -> create();
+	char **keys = NULL, **other = NULL;
+	long nops = 0, cmps;
+	double t0 = 0, t1 = 0;
+	struct rusage ru;
+	int i, bad = 0;
+
+	switch (w)
+	{
+		case W_WORDS:
+			if ((keys = read_words( path, &n)) == NULL)
+			{
+				fprintf( stderr, "cannot open file : %s\n", path);
+				return 1;
+			}
+			cmpCount = 0;
+			t0 = now_ms();
+			for (i = 0; i < n; i++)
+				bad |= ops -> insert( dict, keys[i]) == 0;
+			t1 = now_ms();
+			nops = n;
+			break;
+
+		case W_SORTED:
+		case W_REVERSE:
+			keys = make_keys( n, "");
+			cmpCount = 0;
+			t0 = now_ms();
+			for (i = 0; i < n; i++)
+				bad |= ops -> insert( dict, keys[w == W_SORTED ? i : n - 1 - i]) != 1;
+			t1 = now_ms();
+			nops = n;
+			break;
+
+		case W_ZIPF:
+			keys = make_zipf( n);
+			cmpCount = 0;
+			t0 = now_ms();
+			for (i = 0; i < n; i++)
+				bad |= ops -> insert( dict, keys[i]) == 0;
+			t1 = now_ms();
+			nops = n;
+			break;
+
+		case W_HIT:
+		case W_MISS:
+			keys = make_keys( n, "");
+			shuffle( keys, n);
+			for (i = 0; i < n; i++)
+				ops -> insert( dict, keys[i]);
+			if (w == W_HIT)
+			{
+				other = malloc( sizeof(char *) * (n > 0 ? n : 1));
+				memcpy( other, keys, sizeof(char *) * n);
+			}
+			else
+				other = make_keys( n, "-");
+			shuffle( other, n);
+			cmpCount = 0;
+			t0 = now_ms();
+			for (i = 0; i < n; i++)
+				bad |= ops -> search( dict, other[i]) != (w == W_HIT);
+			t1 = now_ms();
+			nops = n;
+			break;
+
+		case W_DELETE:
+			keys = make_keys( n, "");
+			shuffle( keys, n);
+			for (i = 0; i < n; i++)
+				ops -> insert( dict, keys[i]);
+			shuffle( keys, n);
+			cmpCount = 0;
+			t0 = now_ms();
+			for (i = 0; i < n; i++)
+			{
+				bad |= ops -> remove( dict, keys[i]) != 1;
+				if (i % 2 == 0)
+				{
+					bad |= ops -> insert( dict, keys[i]) != 1;
+					nops++;
+				}
+			}
+			t1 = now_ms();
+			nops += n;
+			break;
+	}
+	cmps = cmpCount;
+	ops -> destroy( dict);
+
+	if (bad)
+	{
+		fprintf( stderr, "%s %s %d : unexpected result\n", ops -> name, workloadName[w], n);
+		return 1;
+	}
+
+	getrusage( RUSAGE_SELF, &ru);
+	printf( "%s,%s,%d,%ld,%.1f,%.2f,%ld\n", ops -> name, workloadName[w], n, nops,
+		nops > 0 ? (t1 - t0) * 1e6 / nops : 0.0, nops > 0 ? (double)cmps / nops : 0.0, ru.ru_maxrss);
+	return 0;
+}
+
+// 실행마다 fork 해서 peak RSS 가 앞선 실행의 영향을 받지 않게 함
+static int spawn( DICT_OPS *ops, int w, int n, const char *path)
+{
+	pid_t pid;
+	int status;
+
+	fflush( stdout);
+	if ((pid = fork()) < 0)
+		return 1;
+	if (pid == 0)
+	{
+		int ret = run( ops, w, n, path);
+		fflush( stdout);
+		_exit( ret);
+	}
+	if (waitpid( pid, &status, 0) < 0)
+		return 1;
+	return !WIFEXITED( status) || WEXITSTATUS( status) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int sizes[16] = { 1000, 10000, 100000 };
+	int nsizes = 3;
+	int maxQuad = 10000;
+	int header = 1;
+	const char *path = "../assignment04/words.txt";
+	int d, w, s, i, failed = 0;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp( argv[i], "-H") == 0)
+			header = 0;
+		else if (strcmp( argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			char *p = argv[++i];
+
+			for (nsizes = 0; *p && nsizes < 16; nsizes++)
+			{
+				sizes[nsizes] = (int)strtol( p, &p, 10);
+				if (*p == ',')
+					p++;
+			}
+		}
+		else if (strcmp( argv[i], "-q") == 0 && i + 1 < argc)
+			maxQuad = atoi( argv[++i]);
+		else if (strcmp( argv[i], "-w") == 0 && i + 1 < argc)
+			path = argv[++i];
+		else
+		{
+			fprintf( stderr, "usage: %s [-H] [-n N,N,...] [-q MAX] [-w FILE]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (header)
+		printf( "structure,workload,n,ops,ns_per_op,cmp_per_op,peak_rss_kb\n");
+
+	for (d = 0; d < dictOpsCount; d++)
+	{
+		DICT_OPS *ops = &dictOps[d];
+
+		failed |= spawn( ops, W_WORDS, 0, path);
+		for (w = W_SORTED; w < W_COUNT; w++)
+		{
+			if (w == W_DELETE && !ops -> canDelete)
+				continue;
+			for (s = 0; s < nsizes; s++)
+			{
+				if (sizes[s] > maxQuad && (ops -> quadratic == DICT_LINEAR ||
+					(ops -> quadratic == DICT_LINEAR_SORTED && (w == W_SORTED || w == W_REVERSE))))
+					continue;
+				failed |= spawn( ops, w, sizes[s], path);
+			}
+		}
+	}
+	return failed;
+}
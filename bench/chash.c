@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc
+#include <string.h> // strlen, strcmp
+#include <ctype.h>  // isspace
+#include <time.h>   // clock_gettime
+#include <pthread.h>
+
+#include "../assignment04/adt_chash.h"
+#include "../assignment04/adt_hash.h"
+#include "../common/word.h"
+
+// 여러 스레드가 사전 하나에 단어 세기: 공유 CHASH 와 스레드별 HASH(shard) + 합치기 비교
+// usage: bench_chash [-m MB] [-t N,N,...] [FILE]
+//	FILE	단어 파일 (default ../assignment04/words.txt), 메모리에 MB 크기가 되도록 반복해서 붙임
+//	MB		입력 크기 (default 1024)
+//	N		스레드 수 목록 (default 1,2,4,8,16)
+//	출력: 방법, 스레드 수, 토큰 수, 단어 수, 시간, MB/s, M tokens/s
+// 입력은 공백을 '\0' 으로 바꿔 두어 토큰마다 복사 없이 '\0' 으로 끝나는 단어가 됨
+// 구간은 '\0' 위치에서 나누므로 단어가 두 스레드에 걸치지 않음
+
+typedef struct
+{
+	char	*from, *to;	// 토큰을 읽을 구간
+	CHASH	*shared;	// 공유 사전 (NULL if shard)
+	HASH	*shard;		// 스레드별 사전
+	long	tokens;
+	int		ok;
+} WORKER;
+
+////////////////////////////////////////////////////////////////////////////////
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// FNV-1a (adt_chash 와 같은 함수)
+static unsigned int hash_word( const void *p)
+{
+	const tWord *w = p;
+	const unsigned char *s = (const unsigned char *)get_word( w);
+	unsigned int h = 2166136261u;
+
+	for (int i = 0; i < w->len; i++)
+	{
+		h ^= s[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void no_dup( const void *p)
+{
+	(void)p;
+}
+
+static void no_free( void *p)
+{
+	(void)p;
+}
+
+// 파일을 size 바이트가 될 때까지 반복해서 붙이고 공백을 '\0' 으로 바꿈
+// return	buffer (NULL if 읽을 수 없음)
+static char *load( const char *path, size_t size, size_t *outSize)
+{
+	FILE *fp = fopen( path, "rb");
+	char *file, *buf;
+	long n;
+	size_t len = 0;
+
+	if (fp == NULL)
+		return NULL;
+	fseek( fp, 0, SEEK_END);
+	n = ftell( fp);
+	rewind( fp);
+	if (n <= 0 || (file = malloc( n + 1)) == NULL || fread( file, 1, n, fp) != (size_t)n)
+	{
+		fclose( fp);
+		return NULL;
+	}
+	fclose( fp);
+	file[n++] = '\n';	// 복사본 사이의 단어가 붙지 않게
+
+	if (size < (size_t)n)
+		size = n;
+	if ((buf = malloc( size + 1)) == NULL)
+	{
+		free( file);
+		return NULL;
+	}
+	while (len + n <= size)
+	{
+		memcpy( buf + len, file, n);
+		len += n;
+	}
+	for (size_t i = 0; i < len; i++)
+		if (isspace( (unsigned char)buf[i]))
+			buf[i] = '\0';
+	buf[len] = '\0';
+
+	free( file);
+	*outSize = len;
+	return buf;
+}
+
+static void *worker_main( void *arg)
+{
+	WORKER *w = arg;
+	char *p = w->from;
+	tWord key;
+	void *out;
+
+	while (p < w->to)
+	{
+		if (*p == '\0')
+		{
+			p++;
+			continue;
+		}
+
+		int len = (int)strlen( p);
+
+		w->tokens++;
+		if (w->shared != NULL)
+		{
+			if (!addCHash( w->shared, p, len))
+				break;
+		}
+		else
+		{
+			set_key( &key, p);
+			if (searchHash( w->shard, &key, &out))
+				((tWord *)out)->freq++;
+			else
+			{
+				tWord *word = createWord( p);
+
+				if (word == NULL || !addHash( w->shard, word, no_dup))
+					break;
+			}
+		}
+		p += len + 1;
+	}
+	w->ok = p >= w->to;
+	return NULL;
+}
+
+// shard 의 단어를 final 로 옮김 (같은 단어는 빈도를 더하고 shard 쪽을 해제)
+static int merge( HASH *final, HASH *shard)
+{
+	void *out;
+
+	for (int i = 0; i < shard->capacity; i++)
+	{
+		tWord *w = shard->slots[i].dataPtr;
+
+		if (w == NULL)
+			continue;
+		if (searchHash( final, w, &out))
+		{
+			((tWord *)out)->freq += w->freq;
+			destroyWord( w);
+		}
+		else if (!addHash( final, w, no_dup))
+			return 0;
+	}
+	destroyHash( shard, no_free);
+	return 1;
+}
+
+// buf 를 nthreads 구간으로 나누어 사전 만들기
+// shared 이면 CHASH 하나를 함께 쓰고, 아니면 스레드별 HASH 를 만든 뒤 *final 로 합침
+// return	토큰 수 (-1 if overflow)
+static long run( char *buf, size_t size, int nthreads, int shared, CHASH **chash, HASH **final)
+{
+	WORKER w[64];
+	pthread_t tid[64];
+	long tokens = 0;
+	int ok = 1;
+
+	if (shared && (*chash = createCHash()) == NULL)
+		return -1;
+	if (!shared && (*final = createHash( compare_by_word, hash_word)) == NULL)
+		return -1;
+
+	char *from = buf;
+	for (int i = 0; i < nthreads; i++)
+	{
+		char *to = i == nthreads - 1 ? buf + size : buf + size / nthreads * (i + 1);
+
+		while (to < buf + size && *to != '\0')
+			to++;
+		if (to < from)
+			to = from;
+		w[i].from = from;
+		w[i].to = to;
+		w[i].shared = shared ? *chash : NULL;
+		w[i].shard = shared ? NULL : createHash( compare_by_word, hash_word);
+		w[i].tokens = 0;
+		w[i].ok = 0;
+		from = to;
+	}
+	for (int i = 0; i < nthreads; i++)
+		pthread_create( &tid[i], NULL, worker_main, &w[i]);
+	for (int i = 0; i < nthreads; i++)
+	{
+		pthread_join( tid[i], NULL);
+		tokens += w[i].tokens;
+		ok &= w[i].ok;
+	}
+	if (!shared)
+		for (int i = 0; i < nthreads; i++)
+			ok &= merge( *final, w[i].shard);
+	return ok ? tokens : -1;
+}
+
+// 두 사전의 단어와 빈도가 같은지 확인
+static CHASH *checkWith;
+static int bad;
+
+static void check_word( const void *p)
+{
+	const tWord *w = p;
+	CWORD *c = searchCHash( checkWith, get_word( w), w->len);
+
+	if (c == NULL || c->freq != w->freq)
+		bad = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	const char *path = "../assignment04/words.txt";
+	size_t mb = 1024, size;
+	int threads[16] = { 1, 2, 4, 8, 16 };
+	int nthreads = 5;
+	char *buf;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp( argv[i], "-m") == 0 && i + 1 < argc)
+			mb = strtoul( argv[++i], NULL, 10);
+		else if (strcmp( argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			char *p = argv[++i];
+
+			for (nthreads = 0; *p && nthreads < 16; nthreads++)
+			{
+				threads[nthreads] = (int)strtol( p, &p, 10);
+				if (*p == ',')
+					p++;
+			}
+		}
+		else
+			path = argv[i];
+	}
+
+	if ((buf = load( path, mb << 20, &size)) == NULL)
+	{
+		fprintf( stderr, "cannot read file : %s\n", path);
+		return 2;
+	}
+
+	printf( "%-8s %8s %11s %8s %10s %9s %9s\n", "method", "threads", "tokens", "words", "ms", "MB/s", "Mtok/s");
+	for (int i = 0; i < nthreads; i++)
+	{
+		CHASH *chash = NULL;
+		HASH *final = NULL;
+		long tokens;
+		double t0, ms;
+
+		if (threads[i] < 1 || threads[i] > 64)
+		{
+			fprintf( stderr, "threads %d : must be 1..64\n", threads[i]);
+			return 1;
+		}
+
+		t0 = now_ms();
+		tokens = run( buf, size, threads[i], 1, &chash, &final);
+		ms = now_ms() - t0;
+		if (tokens < 0)
+		{
+			fprintf( stderr, "chash %d : overflow\n", threads[i]);
+			return 1;
+		}
+		printf( "%-8s %8d %11ld %8d %10.1f %9.1f %9.2f\n", "chash", threads[i], tokens, countCHash( chash),
+			ms, size / 1048576.0 / (ms / 1000), tokens / ms / 1000);
+
+		t0 = now_ms();
+		tokens = run( buf, size, threads[i], 0, &chash, &final);
+		ms = now_ms() - t0;
+		if (tokens < 0)
+		{
+			fprintf( stderr, "shard %d : overflow\n", threads[i]);
+			return 1;
+		}
+		printf( "%-8s %8d %11ld %8d %10.1f %9.1f %9.2f\n", "shard", threads[i], tokens, countHash( final),
+			ms, size / 1048576.0 / (ms / 1000), tokens / ms / 1000);
+
+		checkWith = chash;
+		if (countHash( final) != countCHash( chash))
+			bad = 1;
+		traverseHash( final, check_word);
+		if (bad)
+		{
+			fprintf( stderr, "threads %d : chash differs from shard + merge\n", threads[i]);
+			return 1;
+		}
+		destroyCHash( chash);
+		destroyHash( final, destroyWord);
+	}
+	free( buf);
+	return 0;
+}
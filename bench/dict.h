@@ -0,0 +1,25 @@
+////////////////////////////////////////////////////////////////////////////////
+// DICT_OPS type definition
+// 벤치마크에서 각 사전 구현을 같은 방식으로 호출하기 위한 함수 테이블
+// (dict_mlist.c, dict_dlist.c, dict_bst.c 가 각각 dictOps[] 를 정의)
+#define DICT_LINEAR			1	// insert/search 가 항상 O(n)
+#define DICT_LINEAR_SORTED	2	// 정렬된 입력(sorted, reverse)에서만 O(n)
+
+typedef struct
+{
+	const char	*name;
+	int		quadratic;	// DICT_LINEAR or DICT_LINEAR_SORTED (큰 n 은 건너뜀), 0 otherwise
+	int		canDelete;	// 0 if the structure has no delete operation
+	void	*(*create)( void);
+	int		(*insert)( void *dict, char *key);	// 1 inserted, 2 duplicated, 0 overflow
+	int		(*search)( void *dict, char *key);	// 1 found, 0 not found
+	int		(*remove)( void *dict, char *key);	// 1 deleted, 0 not found
+	void	(*destroy)( void *dict);
+} DICT_OPS;
+
+// 구현 목록 (adapter 파일에서 정의)
+extern DICT_OPS dictOps[];
+extern int dictOpsCount;
+
+// 키 비교 횟수 (adapter 의 compare 함수가 증가시킴)
+extern long cmpCount;
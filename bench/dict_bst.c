@@ -0,0 +1,63 @@
+#include <string.h> // strcmp
+
+#include "../assignment05/bst.h"
+#include "dict.h"
+
+// assignment05 의 이진 탐색 트리 (BST_PLAIN / BST_AVL)
+
+////////////////////////////////////////////////////////////////////////////////
+static int compare_str( const void *p1, const void *p2)
+{
+	cmpCount++;
+	return strcmp( (const char *)p1, (const char *)p2);
+}
+
+static void no_dup( void *p)
+{
+	(void)p;
+}
+
+static void no_free( void *p)
+{
+	(void)p;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void *plain_create( void)
+{
+	return BST_CreateEx( compare_str, BST_PLAIN);
+}
+
+static void *avl_create( void)
+{
+	return BST_CreateEx( compare_str, BST_AVL);
+}
+
+static int bst_insert( void *dict, char *key)
+{
+	return BST_Insert( dict, key, no_dup);
+}
+
+static int bst_search( void *dict, char *key)
+{
+	return BST_Search( dict, key) != NULL;
+}
+
+static int bst_remove( void *dict, char *key)
+{
+	return BST_Delete( dict, key) != NULL;
+}
+
+static void bst_destroy( void *dict)
+{
+	BST_Destroy( dict, no_free);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BST_PLAIN 은 정렬 입력에서 O(n) 깊이가 됨
+DICT_OPS dictOps[] =
+{
+	{ "bst", DICT_LINEAR_SORTED, 1, plain_create, bst_insert, bst_search, bst_remove, bst_destroy },
+	{ "bst-avl", 0, 1, avl_create, bst_insert, bst_search, bst_remove, bst_destroy },
+};
+int dictOpsCount = sizeof(dictOps) / sizeof(dictOps[0]);
@@ -0,0 +1,108 @@
+#include <string.h> // strcmp
+
+#include "../assignment04/adt_dlist.h"
+#include "../assignment04/adt_hash.h"
+#include "dict.h"
+
+// assignment04 의 이중 연결 리스트 (일반 / LIST_SKIP) 와 해시 테이블
+
+////////////////////////////////////////////////////////////////////////////////
+static int compare_str( const void *p1, const void *p2)
+{
+	cmpCount++;
+	return strcmp( (const char *)p1, (const char *)p2);
+}
+
+// FNV-1a
+static unsigned int hash_str( const void *p)
+{
+	const unsigned char *s = p;
+	unsigned int h = 2166136261u;
+
+	while (*s)
+	{
+		h ^= *s++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+static void no_dup( const void *p)
+{
+	(void)p;
+}
+
+static void no_free( void *p)
+{
+	(void)p;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void *list_create( void)
+{
+	return createList( compare_str);
+}
+
+static void *skip_create( void)
+{
+	return createListEx( compare_str, LIST_SKIP);
+}
+
+static int list_insert( void *dict, char *key)
+{
+	return addNode( dict, key, no_dup);
+}
+
+static int list_search( void *dict, char *key)
+{
+	void *out;
+	return searchNode( dict, key, &out);
+}
+
+static int list_remove( void *dict, char *key)
+{
+	void *out;
+	return removeNode( dict, key, &out);
+}
+
+static void list_destroy( void *dict)
+{
+	destroyList( dict, no_free);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void *hash_create( void)
+{
+	return createHash( compare_str, hash_str);
+}
+
+static int hash_insert( void *dict, char *key)
+{
+	return addHash( dict, key, no_dup);
+}
+
+static int hash_search( void *dict, char *key)
+{
+	void *out;
+	return searchHash( dict, key, &out);
+}
+
+static int hash_remove( void *dict, char *key)
+{
+	void *out;
+	return removeHash( dict, key, &out);
+}
+
+static void hash_destroy( void *dict)
+{
+	destroyHash( dict, no_free);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DICT_OPS dictOps[] =
+{
+	{ "dlist", DICT_LINEAR, 1, list_create, list_insert, list_search, list_remove, list_destroy },
+	{ "dlist-skip", 0, 1, skip_create, list_insert, list_search, list_remove, list_destroy },
+	{ "hash", 0, 1, hash_create, hash_insert, hash_search, hash_remove, hash_destroy },
+};
+int dictOpsCount = sizeof(dictOps) / sizeof(dictOps[0]);
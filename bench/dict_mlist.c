@@ -0,0 +1,46 @@
+#include <string.h> // memcmp
+
+#include "dict.h"
+
+// assignment_2 의 multi-linked list (헤더가 없는 프로그램이므로 main.c 를 그대로 포함)
+// main 은 이름을 바꾸고, 단어 비교는 모두 compare_by_word 의 memcmp 를 거치므로 memcmp 에서 비교 횟수를 셈
+// (compare_by_word 가 있는 common/word.c 도 같은 매크로로 함께 포함)
+#define main	mlist_main
+#define memcmp( s1, s2, n)	(cmpCount++, memcmp( s1, s2, n))
+#include "../common/word.c"
+#include "../assignment_2/assignment02.p/main.c"
+#undef memcmp
+#undef main
+
+////////////////////////////////////////////////////////////////////////////////
+static void *mlist_create( void)
+{
+	return createList();
+}
+
+static int mlist_insert( void *dict, char *key)
+{
+	return addNode( dict, key);
+}
+
+static int mlist_search( void *dict, char *key)
+{
+	NODE *pPre, *pLoc;
+	tWord argu;
+
+	set_key( &argu, key);
+	return _search( dict, &pPre, &pLoc, &argu);
+}
+
+static void mlist_destroy( void *dict)
+{
+	destroyList( dict);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 삭제 연산이 없음 (delete-heavy workload 는 건너뜀)
+DICT_OPS dictOps[] =
+{
+	{ "mlist", DICT_LINEAR, 0, mlist_create, mlist_insert, mlist_search, NULL, mlist_destroy },
+};
+int dictOpsCount = sizeof(dictOps) / sizeof(dictOps[0]);
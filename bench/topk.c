@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi, realloc
+#include <string.h> // strtol, memcpy
+#include <fcntl.h>  // open
+#include <unistd.h> // dup, dup2
+#include <time.h>   // clock_gettime
+
+// assignment_2 의 빈도순 출력 비교 (헤더가 없는 프로그램이므로 main.c 를 그대로 포함)
+//	full	connect_by_frequency 로 빈도순 리스트 전체를 만든 뒤 print_dic_by_freq
+//	top K	print_dic_top (빈도 bucket 위에서부터 상위 K 개만 골라 출력)
+//	live	단어를 입력하면서 1000 단어마다 top_by_freq( 10) 을 부름 (조회당 평균 시간)
+// usage: bench_topk [FILE [K,K,...]]
+//	FILE	단어 파일 (default ../assignment04/words.txt)
+//	K		상위 개수 목록 (default 10,100,1000)
+//	출력은 /dev/null 로 보내고 시간만 측정 (사전 만들기는 제외)
+#define main	mlist_main
+#include "../assignment_2/assignment02.p/main.c"
+#undef main
+
+////////////////////////////////////////////////////////////////////////////////
+static double now_ms( void)
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// nextToken 의 단어는 '\0' 으로 끝나지 않으므로 복사해서 addNode 에 넘김
+// return	addNode 의 반환값 (0 if overflow)
+static int add_token( LIST *list, const char *word, size_t len)
+{
+	static char *buf;
+	static size_t size;
+
+	if (len + 1 > size)
+	{
+		char *p = realloc( buf, len + 1);
+		if (p == NULL)
+			return 0;
+		buf = p;
+		size = len + 1;
+	}
+	memcpy( buf, word, len);
+	buf[len] = '\0';
+	return addNode( list, buf);
+}
+
+// stdout 을 /dev/null 로 돌림
+// return	원래 stdout 의 복사본 (restore_stdout 에 넘김)
+static int mute_stdout( void)
+{
+	int saved, null;
+
+	fflush( stdout);
+	saved = dup( 1);
+	null = open( "/dev/null", O_WRONLY);
+	dup2( null, 1);
+	close( null);
+	return saved;
+}
+
+static void restore_stdout( int saved)
+{
+	fflush( stdout);
+	dup2( saved, 1);
+	close( saved);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "../assignment04/words.txt";
+	int ks[16] = { 10, 100, 1000 };
+	int nks = 3;
+	int rounds = 20;
+	LIST *list;
+	TOKENIZER tok;
+	const char *word;
+	size_t len;
+	double t0, t1;
+	int i, r, saved;
+
+	if (argc > 2)
+	{
+		char *p = argv[2];
+
+		for (nks = 0; *p && nks < 16; nks++)
+		{
+			ks[nks] = (int)strtol( p, &p, 10);
+			if (*p == ',')
+				p++;
+		}
+	}
+
+	if ((list = createList()) == NULL)
+		return 100;
+	if (!openTokenizer( &tok, path))
+	{
+		fprintf( stderr, "cannot open file : %s\n", path);
+		return 2;
+	}
+	while (nextToken( &tok, &word, &len))
+		if (add_token( list, word, len) == 0)
+		{
+			fprintf( stderr, "memory overflow\n");
+			return 1;
+		}
+	closeTokenizer( &tok);
+
+	printf( "%-8s %9s %9s %12s\n", "query", "words", "K", "ms/query");
+
+	saved = mute_stdout();
+	t0 = now_ms();
+	for (r = 0; r < rounds; r++)
+	{
+		connect_by_frequency( list);
+		print_dic_by_freq( list);
+	}
+	t1 = now_ms();
+	restore_stdout( saved);
+	printf( "%-8s %9d %9s %12.4f\n", "full", list->count, "-", (t1 - t0) / rounds);
+
+	for (i = 0; i < nks; i++)
+	{
+		saved = mute_stdout();
+		t0 = now_ms();
+		for (r = 0; r < rounds; r++)
+			print_dic_top( list, ks[i]);
+		t1 = now_ms();
+		restore_stdout( saved);
+		printf( "%-8s %9d %9d %12.4f\n", "top", list->count, ks[i], (t1 - t0) / rounds);
+	}
+
+	destroyList( list);
+
+	// 입력 중 주기적인 상위 단어 조회 (조회 시간만 합산, 선형 리스트 삽입 시간은 제외)
+	{
+		tWord *top[10];
+		double total = 0;
+		long n = 0, queries = 0;
+
+		if ((list = createList()) == NULL || !openTokenizer( &tok, path))
+			return 100;
+		while (nextToken( &tok, &word, &len))
+		{
+			if (add_token( list, word, len) == 0)
+				return 1;
+			if (++n % 1000 == 0)
+			{
+				t0 = now_ms();
+				for (r = 0; r < rounds; r++)
+					top_by_freq( list, 10, top);
+				total += now_ms() - t0;
+				queries += rounds;
+			}
+		}
+		closeTokenizer( &tok);
+		printf( "%-8s %9d %9d %12.4f\n", "live", list->count, 10, queries > 0 ? total / queries : 0.0);
+	}
+
+	destroyList( list);
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdlib.h> // malloc
+
+#include "arena.h"
+
+// 아레나의 현재 블록에서 size 바이트를 잘라 줌 (부족하면 새 블록 할당)
+// return    할당된 메모리에 대한 pointer
+//            NULL if overflow
+void *arenaAlloc( BLOCK **pArena, size_t size){
+    BLOCK *block = *pArena;
+    
+    // 포인터 크기 단위로 정렬
+    size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    
+    if(block == NULL || block -> used + size > block -> size){
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        
+        block = malloc(sizeof(BLOCK) + blockSize);
+        if(block == NULL) return NULL;
+        
+        block -> next = *pArena;
+        block -> used = 0;
+        block -> size = blockSize;
+        *pArena = block;
+    }
+    
+    void *p = block -> data + block -> used;
+    block -> used += size;
+    return p;
+}
+
+// src 아레나의 블록을 *pDst 의 현재 블록 뒤에 이어 붙임 (현재 블록은 그대로)
+void mergeArena( BLOCK **pDst, BLOCK *src){
+    if(src == NULL) return;
+    
+    if(*pDst == NULL){
+        *pDst = src;
+        return;
+    }
+    
+    BLOCK *last = src;
+    while(last -> next != NULL){
+        last = last -> next;
+    }
+    last -> next = (*pDst) -> next;
+    (*pDst) -> next = src;
+}
+
+// 아레나의 블록을 모두 해제
+void destroyArena( BLOCK *arena){
+    while(arena != NULL){
+        BLOCK *next = arena -> next;
+        free(arena);
+        arena = next;
+    }
+}
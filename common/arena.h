@@ -0,0 +1,35 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// BLOCK type definition
+// 아레나 블록: 단어 구조체, 단어 문자열, 노드를 앞에서부터 이어 붙여 저장
+// 한 번 저장한 데이터는 따로 해제하지 않고 destroyArena 에서 블록 단위로 한꺼번에 해제
+// 아레나는 가장 최근 블록에 대한 pointer 하나로 나타냄 (NULL 이면 빈 아레나)
+#define ARENA_BLOCK_SIZE    (64 * 1024)
+
+typedef struct block{
+    struct block    *next;
+    size_t    used; // 사용한 바이트 수
+    size_t    size; // data 영역 크기
+    char    data[];
+} BLOCK;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+// 아레나의 현재 블록에서 size 바이트를 잘라 줌 (부족하면 새 블록을 할당해서 *pArena 로)
+// return    할당된 메모리에 대한 pointer
+//            NULL if overflow
+void *arenaAlloc( BLOCK **pArena, size_t size);
+
+// src 아레나의 블록을 *pDst 의 현재 블록 뒤에 이어 붙임 (현재 블록은 그대로)
+// src 에 할당된 데이터는 그대로 남고 이후에는 *pDst 와 함께 해제됨
+void mergeArena( BLOCK **pDst, BLOCK *src);
+
+// 아레나의 블록을 모두 해제
+void destroyArena( BLOCK *arena);
+
+#endif
@@ -0,0 +1,226 @@
+#include <stddef.h> // NULL
+
+#include "freq_bucket.h"
+
+// internal function
+// for addFreqNode, incFreqNode, rebuildFreqIndex functions
+// 빈도 freq 인 빈 bucket 을 up 과 down 사이에 연결 (비워진 bucket 이 있으면 재사용)
+// return    bucket pointer
+//            NULL if overflow
+static BUCKET *_bucket_create( FREQ_INDEX *pIndex, BLOCK **pArena, int freq, BUCKET *up, BUCKET *down){
+    BUCKET *newBucket = pIndex -> freeBuckets;
+
+    if(newBucket != NULL){
+        pIndex -> freeBuckets = newBucket -> down;
+    }
+    else{
+        newBucket = arenaAlloc(pArena, sizeof(BUCKET));
+        if(newBucket == NULL) return NULL;
+    }
+
+    newBucket -> freq = freq;
+    newBucket -> count = 0;
+    newBucket -> sorted = 1;
+    newBucket -> first = NULL;
+    newBucket -> last = NULL;
+    newBucket -> up = up;
+    newBucket -> down = down;
+
+    if(up == NULL) pIndex -> top = newBucket;
+    else up -> down = newBucket;
+    if(down == NULL) pIndex -> bottom = newBucket;
+    else down -> up = newBucket;
+
+    return newBucket;
+}
+
+// internal function
+// 노드를 bucket 끝에 붙임 (앞 노드보다 단어순으로 앞이면 sorted = 0)
+static void _bucket_append( BUCKET *pBucket, FNODE *pNode){
+    pNode -> bucket = pBucket;
+    pNode -> link2 = NULL;
+    pNode -> prev2 = pBucket -> last;
+
+    if(pBucket -> last == NULL){
+        pBucket -> first = pNode;
+    }
+    else{
+        if(pBucket -> sorted && compare_by_word(pBucket -> last -> dataPtr, pNode -> dataPtr) > 0){
+            pBucket -> sorted = 0;
+        }
+        pBucket -> last -> link2 = pNode;
+    }
+    pBucket -> last = pNode;
+    pBucket -> count++;
+}
+
+// internal function
+// for addFreqNode, incFreqNode functions
+// from 부터 위로 올라가며 빈도 freq 인 bucket 을 찾음 (없으면 그 자리에 만듦)
+//    from    빈도가 freq 이하인 bucket (NULL 이면 가장 위 bucket 위에 만듦)
+// return    bucket pointer
+//            NULL if overflow
+static BUCKET *_bucket_find( FREQ_INDEX *pIndex, BLOCK **pArena, BUCKET *from, int freq){
+    BUCKET *up = from;
+
+    while(up != NULL && up -> freq < freq){
+        up = up -> up;
+    }
+    if(up != NULL && up -> freq == freq) return up;
+
+    return _bucket_create(pIndex, pArena, freq, up, up != NULL ? up -> down : pIndex -> top);
+}
+
+// internal function
+// for _sort_by_freq function
+// link2 로 연결된, 빈도순으로 정렬된 두 리스트를 병합
+// return    병합된 리스트의 첫번째 노드
+static FNODE *_merge_by_freq( FNODE *a, FNODE *b){
+    FNODE dummy;
+    FNODE *tail = &dummy;
+
+    while(a != NULL && b != NULL){
+        // 같으면 a(앞쪽 원소)를 먼저 - 안정 정렬
+        if(compare_by_freq(b -> dataPtr, a -> dataPtr) < 0){
+            tail -> link2 = b;
+            b = b -> link2;
+        }
+        else{
+            tail -> link2 = a;
+            a = a -> link2;
+        }
+        tail = tail -> link2;
+    }
+    tail -> link2 = (a != NULL) ? a : b;
+
+    return dummy.link2;
+}
+
+// internal function
+// for sortBucket, rebuildFreqIndex functions
+// link2 로 연결된 노드들을 compare_by_freq 순서로 정렬 (prev2 는 건드리지 않음)
+// bottom-up merge sort: bins[i] 에는 2^i 개짜리 정렬된 리스트를 보관하고
+// 노드를 하나씩 넣으며 같은 크기끼리 병합 (O(n log n), 재귀 없음)
+// return    정렬된 리스트의 첫번째 노드
+static FNODE *_sort_by_freq( FNODE *first){
+    FNODE *bins[64] = { NULL };
+    FNODE *cur = first;
+    FNODE *sorted = NULL;
+    int i;
+
+    while (cur != NULL) {
+        FNODE *run = cur;
+
+        cur = cur->link2;
+        run->link2 = NULL;
+
+        for (i = 0; bins[i] != NULL; i++) {
+            run = _merge_by_freq(bins[i], run);
+            bins[i] = NULL;
+        }
+        bins[i] = run;
+    }
+
+    // 남은 bin 들을 작은 것(뒤쪽 원소)부터 병합
+    for (i = 0; i < 64; i++) {
+        if (bins[i] != NULL) {
+            sorted = _merge_by_freq(bins[i], sorted);
+        }
+    }
+    return sorted;
+}
+
+// 빈 빈도 index 로 초기화
+void initFreqIndex( FREQ_INDEX *pIndex){
+    pIndex -> top = NULL;
+    pIndex -> bottom = NULL;
+    pIndex -> freeBuckets = NULL;
+}
+
+// 새 노드를 빈도에 맞는 bucket 에 넣음 (빈도 1 이면 가장 아래 bucket, O(1))
+// return    1 if successful
+//            0 if memory overflow
+int addFreqNode( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *pNode){
+    BUCKET *pBucket = _bucket_find(pIndex, pArena, pIndex -> bottom, pNode -> dataPtr -> freq);
+    if(pBucket == NULL) return 0;
+
+    _bucket_append(pBucket, pNode);
+    return 1;
+}
+
+// 빈도를 delta 만큼 늘리고 노드를 위쪽 bucket 으로 옮김 (없으면 만듦, delta 가 1 이면 O(1))
+// return    1 if successful
+//            0 if memory overflow (빈도는 그대로)
+int incFreqNode( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *pNode, int delta){
+    int freq = pNode -> dataPtr -> freq + delta;
+    BUCKET *up = _bucket_find(pIndex, pArena, pNode -> bucket -> up, freq);
+    if(up == NULL) return 0;
+
+    pNode -> dataPtr -> freq = freq;
+    removeFreqNode(pIndex, pNode);
+    _bucket_append(up, pNode);
+    return 1;
+}
+
+// 노드를 bucket 에서 떼어 냄 (순서는 유지), bucket 이 비면 bucket 목록에서 빼고 재사용 목록에 넣음
+void removeFreqNode( FREQ_INDEX *pIndex, FNODE *pNode){
+    BUCKET *pBucket = pNode -> bucket;
+
+    if(pNode -> prev2 == NULL) pBucket -> first = pNode -> link2;
+    else pNode -> prev2 -> link2 = pNode -> link2;
+    if(pNode -> link2 == NULL) pBucket -> last = pNode -> prev2;
+    else pNode -> link2 -> prev2 = pNode -> prev2;
+
+    if(--pBucket -> count > 0) return;
+
+    if(pBucket -> up == NULL) pIndex -> top = pBucket -> down;
+    else pBucket -> up -> down = pBucket -> down;
+    if(pBucket -> down == NULL) pIndex -> bottom = pBucket -> up;
+    else pBucket -> down -> up = pBucket -> up;
+
+    pBucket -> down = pIndex -> freeBuckets;
+    pIndex -> freeBuckets = pBucket;
+}
+
+// 모든 bucket 을 비우고, 노드를 빈도순으로 정렬해서 bucket 을 다시 만듦 (O(n log n))
+// return    1 if successful
+//            0 if memory overflow
+int rebuildFreqIndex( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *first){
+    while(pIndex -> top != NULL){
+        BUCKET *pBucket = pIndex -> top;
+
+        pIndex -> top = pBucket -> down;
+        pBucket -> down = pIndex -> freeBuckets;
+        pIndex -> freeBuckets = pBucket;
+    }
+    pIndex -> bottom = NULL;
+
+    // 빈도순(같은 빈도는 단어순)으로 정렬된 노드를 차례로 가장 아래 bucket 에 붙임
+    FNODE *cur = _sort_by_freq(first);
+    while(cur != NULL){
+        FNODE *next = cur -> link2;
+
+        if(pIndex -> bottom == NULL || pIndex -> bottom -> freq != cur -> dataPtr -> freq){
+            if(_bucket_create(pIndex, pArena, cur -> dataPtr -> freq, pIndex -> bottom, NULL) == NULL) return 0;
+        }
+        _bucket_append(pIndex -> bottom, cur);
+        cur = next;
+    }
+    return 1;
+}
+
+// bucket 안의 노드를 단어순으로 정렬 (sorted 가 0 일 때만)
+void sortBucket( BUCKET *pBucket){
+    if(pBucket -> sorted) return;
+
+    FNODE *prev = NULL;
+
+    // 같은 빈도이므로 compare_by_freq 순서 = 단어순
+    pBucket -> first = _sort_by_freq(pBucket -> first);
+    for(FNODE *cur = pBucket -> first; cur != NULL; cur = cur -> link2){
+        cur -> prev2 = prev;
+        prev = cur;
+    }
+    pBucket -> last = prev;
+    pBucket -> sorted = 1;
+}
@@ -0,0 +1,69 @@
+#ifndef FREQ_BUCKET_H
+#define FREQ_BUCKET_H
+
+#include "arena.h" // BLOCK
+#include "word.h" // tWord
+
+////////////////////////////////////////////////////////////////////////////////
+// FREQ_INDEX type definition
+// 빈도 bucket: 빈도가 같은 노드들을 link2/prev2 로 이은 이중 연결 리스트
+// bucket 끼리는 빈도 내림차순으로 이중 연결 (O(1) LFU 와 같은 구조)
+// 빈도가 1 늘면 노드를 바로 위 bucket 으로 옮기므로 빈도순 보기가 항상 최신
+// 사전의 노드는 FNODE 를 첫 멤버로 두고, bucket 은 사전의 아레나에 할당
+
+// 빈도 bucket 에 들어가는 노드 부분
+typedef struct fnode{
+    tWord    *dataPtr;
+    struct fnode    *link2; // 같은 빈도 bucket 안의 다음 노드
+    struct fnode    *prev2; // 같은 빈도 bucket 안의 이전 노드
+    struct bucket    *bucket; // 노드가 속한 빈도 bucket
+} FNODE;
+
+typedef struct bucket{
+    int        freq; // bucket 안 단어들의 빈도
+    int        count; // bucket 안의 노드 수
+    int        sorted; // 1 if first 부터 link2 순서가 단어순
+    struct bucket    *up; // 빈도가 더 큰 쪽 bucket (NULL if 가장 큰 빈도)
+    struct bucket    *down; // 빈도가 더 작은 쪽 bucket (NULL if 가장 작은 빈도)
+    FNODE    *first;
+    FNODE    *last;
+} BUCKET;
+
+typedef struct{
+    BUCKET    *top; // 빈도가 가장 큰 bucket (빈도순 보기의 시작)
+    BUCKET    *bottom; // 빈도가 가장 작은 bucket (새 단어가 들어감)
+    BUCKET    *freeBuckets; // 비워진 bucket (down 으로 연결, 재사용)
+} FREQ_INDEX;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+// 빈 빈도 index 로 초기화
+void initFreqIndex( FREQ_INDEX *pIndex);
+
+// 새 노드를 빈도(pNode -> dataPtr -> freq)에 맞는 bucket 에 넣음 (빈도 1 이면 가장 아래 bucket, O(1))
+//    pArena    bucket 을 새로 만들 때 쓸 아레나
+// return    1 if successful
+//            0 if memory overflow
+int addFreqNode( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *pNode);
+
+// 빈도를 delta 만큼 늘리고 노드를 위쪽 bucket 으로 옮김 (없으면 만듦, delta 가 1 이면 O(1))
+// return    1 if successful
+//            0 if memory overflow (빈도는 그대로)
+int incFreqNode( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *pNode, int delta);
+
+// 노드를 bucket 에서 떼어 냄, bucket 이 비면 bucket 목록에서 빼고 재사용 목록에 넣음
+void removeFreqNode( FREQ_INDEX *pIndex, FNODE *pNode);
+
+// 모든 bucket 을 비우고 link2 로 연결한 노드들로 bucket 을 다시 만듦 (O(n log n))
+// 빈도가 한 번에 여러 칸 바뀌었을 때 (사전 병합 등) 사용
+//    first    사전의 모든 노드를 link2 로 연결한 리스트
+// return    1 if successful
+//            0 if memory overflow
+int rebuildFreqIndex( FREQ_INDEX *pIndex, BLOCK **pArena, FNODE *first);
+
+// bucket 안의 노드를 단어순으로 정렬 (마지막 정렬 이후 순서가 흐트러졌을 때만)
+// 빈도순 출력 전에 bucket 마다 부름
+void sortBucket( BUCKET *pBucket);
+
+#endif
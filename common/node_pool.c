@@ -0,0 +1,104 @@
+#include <stdlib.h> // malloc
+#include <stddef.h> // max_align_t
+
+#include "node_pool.h"
+
+#define POOL_DEFAULT_NODES	4096
+
+// 슬랩 헤더 뒤에 오는 노드들이 max_align_t 에 정렬되도록 올림
+// (포인터 크기로만 올리면 32-bit 에서 노드 안의 uint64_t, double 필드가 어긋남)
+#define POOL_ALIGN( size)	(((size) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+/* Allocates dynamic memory for a pool head
+	nodeSize		size of a node (sizeof(NODE))
+	nodesPerSlab	number of nodes in a slab (0 for default)
+	return	pool head pointer
+			NULL if overflow
+*/
+POOL *POOL_Create( size_t nodeSize, int nodesPerSlab){
+	POOL *pool = malloc(sizeof(POOL));
+	if(pool == NULL) return NULL;
+
+	// free list 링크를 저장할 수 있어야 함
+	if(nodeSize < sizeof(void *)) nodeSize = sizeof(void *);
+
+	pool -> nodeSize = POOL_ALIGN(nodeSize);
+	pool -> nodesPerSlab = nodesPerSlab > 0 ? nodesPerSlab : POOL_DEFAULT_NODES;
+	pool -> slabs = NULL;
+	pool -> cur = NULL;
+	pool -> end = NULL;
+	pool -> freeList = NULL;
+
+	return pool;
+}
+
+/* Releases all slabs and the pool head at once
+	(individual nodes need not be freed)
+*/
+void POOL_Destroy( POOL *pPool){
+	SLAB *slab = pPool -> slabs;
+
+	while(slab != NULL){
+		SLAB *next = slab -> next;
+		free(slab);
+		slab = next;
+	}
+	free(pPool);
+}
+
+// internal function
+// for POOL_Alloc, POOL_Reserve functions
+// nodes 개가 들어가는 슬랩을 할당해서 현재 슬랩으로 만듦
+// return	1 success
+//			0 overflow
+static int _newSlab( POOL *pPool, size_t nodes){
+	size_t header = POOL_ALIGN(sizeof(SLAB));
+	SLAB *slab = malloc(header + pPool -> nodeSize * nodes);
+	if(slab == NULL) return 0;
+
+	slab -> next = pPool -> slabs;
+	pPool -> slabs = slab;
+	pPool -> cur = (char *)slab + header;
+	pPool -> end = pPool -> cur + pPool -> nodeSize * nodes;
+	return 1;
+}
+
+/* Returns a node from the free list or the current slab
+	return	address of node
+			NULL if overflow
+*/
+void *POOL_Alloc( POOL *pPool){
+	if(pPool -> freeList != NULL){
+		void *node = pPool -> freeList;
+		pPool -> freeList = *(void **)node;
+		return node;
+	}
+
+	if(pPool -> cur == pPool -> end){
+		if(!_newSlab(pPool, pPool -> nodesPerSlab)) return NULL;
+	}
+
+	void *node = pPool -> cur;
+	pPool -> cur += pPool -> nodeSize;
+	return node;
+}
+
+/* Makes the next n nodes from POOL_Alloc contiguous (in allocation order)
+	현재 슬랩에 n개가 남아 있지 않으면 n개 이상 들어가는 슬랩을 새로 할당
+	return	1 success
+			0 overflow
+*/
+int POOL_Reserve( POOL *pPool, int n){
+	size_t left = (size_t)(pPool -> end - pPool -> cur) / pPool -> nodeSize;
+
+	if(n <= 0 || (size_t)n <= left) return 1;
+
+	return _newSlab(pPool, n > pPool -> nodesPerSlab ? n : pPool -> nodesPerSlab);
+}
+
+/* Returns a node to the free list
+*/
+void POOL_Free( POOL *pPool, void *node){
+	*(void **)node = pPool -> freeList;
+	pPool -> freeList = node;
+}
@@ -0,0 +1,59 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// POOL type definition
+// 같은 크기의 노드를 큰 슬랩(slab) 단위로 할당하는 메모리 풀
+// 해제된 노드는 노드 자체의 첫 word 를 링크로 쓰는 free list 에 보관했다가 재사용
+typedef struct slab
+{
+	struct slab	*next;
+} SLAB;
+
+typedef struct pool
+{
+	size_t	nodeSize;		// 정렬된 노드 크기
+	int		nodesPerSlab;	// 슬랩 하나에 들어가는 노드 수
+	SLAB	*slabs;			// 할당된 슬랩 리스트
+	char	*cur;			// 현재 슬랩에서 아직 쓰지 않은 영역의 시작
+	char	*end;			// 현재 슬랩의 끝
+	void	*freeList;		// 해제된 노드 리스트
+} POOL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a pool head
+	nodeSize		size of a node (sizeof(NODE))
+	nodesPerSlab	number of nodes in a slab (0 for default)
+	return	pool head pointer
+			NULL if overflow
+*/
+POOL *POOL_Create( size_t nodeSize, int nodesPerSlab);
+
+/* Releases all slabs and the pool head at once
+	(individual nodes need not be freed)
+*/
+void POOL_Destroy( POOL *pPool);
+
+/* Returns a node from the free list or the current slab
+	return	address of node
+			NULL if overflow
+*/
+void *POOL_Alloc( POOL *pPool);
+
+/* Makes the next n nodes from POOL_Alloc contiguous (in allocation order)
+	현재 슬랩에 n개가 남아 있지 않으면 n개 이상 들어가는 슬랩을 새로 할당
+	(현재 슬랩의 남은 영역은 버림, free list 의 노드는 여전히 먼저 재사용됨)
+	return	1 success
+			0 overflow
+*/
+int POOL_Reserve( POOL *pPool, int n);
+
+/* Returns a node to the free list
+*/
+void POOL_Free( POOL *pPool, void *node);
+
+#endif
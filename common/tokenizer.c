@@ -0,0 +1,156 @@
+#include <fcntl.h> // open
+#include <unistd.h> // close, sysconf
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#if defined(__AVX2__)
+#include <immintrin.h> // AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h> // SSE2
+#endif
+
+#include "tokenizer.h"
+
+// 공백 문자 (fscanf "%s" 와 같은 기준: ' ', '\t', '\n', '\v', '\f', '\r')
+static int _is_space( unsigned char c){
+    return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t';
+}
+
+#if defined(__AVX2__)
+#define TOK_WIDTH    32
+// p[0..31] 중 공백인 바이트의 비트 마스크
+static unsigned int _space_mask( const char *p){
+    __m256i v = _mm256_loadu_si256((const __m256i *)p);
+    __m256i t = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+    __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8('\r' - '\t')), t);
+    __m256i sp = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    return (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(ctl, sp));
+}
+#elif defined(__SSE2__)
+#define TOK_WIDTH    16
+// p[0..15] 중 공백인 바이트의 비트 마스크
+static unsigned int _space_mask( const char *p){
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    __m128i ctl = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('\r' - '\t')), t);
+    __m128i sp = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    return (unsigned int)_mm_movemask_epi8(_mm_or_si128(ctl, sp));
+}
+#endif
+
+// from 부터 처음으로 공백 여부가 space 와 같은 위치
+// for nextToken, tokenizerSplit functions
+// return    위치 (없으면 size)
+static size_t _scan( TOKENIZER *pTok, size_t from, int space){
+    size_t i = from;
+    
+#ifdef TOK_WIDTH
+    while(i + TOK_WIDTH <= pTok -> size){
+        unsigned int mask = _space_mask(pTok -> data + i);
+        if(!space) mask = ~mask;
+#if TOK_WIDTH < 32
+        mask &= (1u << TOK_WIDTH) - 1;
+#endif
+        if(mask != 0) return i + __builtin_ctz(mask);
+        i += TOK_WIDTH;
+    }
+#endif
+    // scalar (SIMD 가 없거나 파일 끝의 남은 바이트)
+    while(i < pTok -> size && _is_space(pTok -> data[i]) != space){
+        i++;
+    }
+    return i;
+}
+
+// 파일을 열어 tokenizer 초기화
+// return    1 if successful
+//            0 if cannot open or map file
+int openTokenizer( TOKENIZER *pTok, const char *path){
+    return openTokenizerAt(pTok, path, 0, 1);
+}
+
+// 파일의 from 바이트부터 읽도록 tokenizer 초기화
+// mmap 은 page 경계에서 시작해야 하므로 from 이 속한 page 부터 매핑하고 pos 를 그만큼 옮김
+// return    1 if successful
+//            0 if cannot open or map file
+int openTokenizerAt( TOKENIZER *pTok, const char *path, size_t from, int whole){
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return 0;
+    
+    if(fstat(fd, &st) < 0 || (size_t)st.st_size < from){
+        close(fd);
+        return 0;
+    }
+    
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    
+    pTok -> offset = from - from % page;
+    pTok -> size = (size_t)st.st_size - pTok -> offset;
+    pTok -> mapped = pTok -> size;
+    pTok -> pos = from - pTok -> offset;
+    pTok -> data = NULL;
+    
+    // 읽기 전용: 단어에 '\0' 을 쓰지 않으므로 page 가 복사되지 않음 (page cache 를 그대로 씀)
+    if(pTok -> size > 0){
+        void *p = mmap(NULL, pTok -> size, PROT_READ, MAP_PRIVATE, fd, (off_t)pTok -> offset);
+        if(p == MAP_FAILED){
+            close(fd);
+            return 0;
+        }
+        pTok -> data = p;
+        madvise(p, pTok -> size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    
+    // 쓰는 중인 마지막 단어는 남겨 둠 (공백 바로 뒤까지만 읽음)
+    if(!whole){
+        while(pTok -> size > pTok -> pos && !_is_space(pTok -> data[pTok -> size - 1])){
+            pTok -> size--;
+        }
+    }
+    
+    return 1;
+}
+
+// pTok 의 data[from, to) 만 읽는 tokenizer 를 pPart 에 만듦 (mmap 은 pTok 의 것을 함께 씀)
+void subTokenizer( TOKENIZER *pPart, TOKENIZER *pTok, size_t from, size_t to){
+    pPart -> data = pTok -> data + from;
+    pPart -> size = to - from;
+    pPart -> mapped = 0;
+    pPart -> offset = pTok -> offset + from;
+    pPart -> pos = 0;
+}
+
+// data 의 at 위치부터 처음 나오는 공백 위치
+// return    위치 (없으면 size)
+size_t tokenizerSplit( TOKENIZER *pTok, size_t at){
+    return at < pTok -> size ? _scan(pTok, at, 1) : pTok -> size;
+}
+
+// 지금까지 읽은 위치 (파일 내 바이트 offset)
+size_t tokenizerPos( TOKENIZER *pTok){
+    return pTok -> offset + pTok -> pos;
+}
+
+// 다음 단어 (pointer, length) 를 넘겨줌, *word 는 mmap 된 영역을 그대로 가리킴 ('\0' 없음)
+// return    1 if a word is returned
+//            0 end of file
+int nextToken( TOKENIZER *pTok, const char **word, size_t *len){
+    size_t start = _scan(pTok, pTok -> pos, 0);
+    if(start >= pTok -> size) return 0;
+    
+    size_t end = _scan(pTok, start, 1);
+    
+    *word = pTok -> data + start;
+    *len = end - start;
+    pTok -> pos = end;
+    return 1;
+}
+
+// mmap 해제 (subTokenizer 로 만든 범위는 아무것도 하지 않음)
+void closeTokenizer( TOKENIZER *pTok){
+    if(pTok -> mapped > 0){
+        munmap((void *)pTok -> data, pTok -> mapped);
+    }
+    pTok -> data = NULL;
+}
@@ -0,0 +1,53 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// TOKENIZER type definition
+// 입력 파일을 읽기 전용으로 mmap 하고 공백(isspace) 경계를 SIMD 로 찾아 단어를 하나씩 넘겨줌
+// 단어는 mmap 된 영역의 (pointer, length) 로 넘겨주고 '\0' 을 쓰지 않음 (page 를 복사하지 않으므로 입력 크기만큼 메모리를 더 쓰지 않음)
+typedef struct{
+    const char    *data; // 읽기 전용으로 mmap 된 파일 내용 (offset 부터)
+    size_t    size; // data 에서 읽을 바이트 수
+    size_t    mapped; // mmap 한 바이트 수 (munmap 용, 0 if 다른 tokenizer 의 mmap 을 함께 씀)
+    size_t    offset; // data[0] 의 파일 내 위치
+    size_t    pos; // 다음 검색 위치
+} TOKENIZER;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+// 파일을 열어 tokenizer 초기화
+// return    1 if successful
+//            0 if cannot open or map file
+int openTokenizer( TOKENIZER *pTok, const char *path);
+
+// 파일의 from 바이트부터 읽도록 tokenizer 초기화 (앞부분은 mmap 하지 않음)
+//    whole    0 이면 파일 끝의 공백으로 끝나지 않은 단어는 읽지 않음 (아직 쓰는 중일 수 있음)
+// return    1 if successful
+//            0 if cannot open or map file
+int openTokenizerAt( TOKENIZER *pTok, const char *path, size_t from, int whole);
+
+// pTok 의 data[from, to) 만 읽는 tokenizer 를 pPart 에 만듦 (mmap 은 pTok 의 것을 함께 씀)
+// 여러 스레드가 한 파일을 나누어 읽을 때 사용, pPart 는 pTok 보다 먼저 closeTokenizer
+//    to    tokenizerSplit 이 돌려준 위치 (단어가 두 범위에 걸치지 않음)
+void subTokenizer( TOKENIZER *pPart, TOKENIZER *pTok, size_t from, size_t to);
+
+// data 의 at 위치부터 처음 나오는 공백 위치 (범위 경계로 쓰면 단어가 잘리지 않음)
+// return    위치 (없으면 size)
+size_t tokenizerSplit( TOKENIZER *pTok, size_t at);
+
+// 지금까지 읽은 위치 (파일 내 바이트 offset)
+size_t tokenizerPos( TOKENIZER *pTok);
+
+// 다음 단어 (pointer, length) 를 넘겨줌, *word 는 '\0' 으로 끝나지 않음 (set_key_len 으로 키를 만듦)
+// *word 는 closeTokenizer 전까지 유효
+// return    1 if a word is returned
+//            0 end of file
+int nextToken( TOKENIZER *pTok, const char **word, size_t *len);
+
+// mmap 해제
+void closeTokenizer( TOKENIZER *pTok);
+
+#endif
@@ -0,0 +1,112 @@
+#include <stdlib.h> // malloc
+#include <string.h> // strlen, memcpy, memcmp
+
+#include "word.h"
+
+/* Allocates dynamic memory for a word structure (freq = 1)
+	return	word structure pointer
+			NULL if overflow
+*/
+tWord *createWord( char *word){
+	size_t len = strlen(word);
+
+	// 긴 단어만 문자열을 구조체 바로 뒤에 저장 (할당은 한 번)
+	void *pWord = malloc(word_size(len));
+	if(pWord == NULL) return NULL;
+
+	return initWord(pWord, word, len);
+}
+
+/* returns size of a word structure holding a word of len bytes ('\0' 제외)
+*/
+size_t word_size( size_t len){
+	return sizeof(tWord) + (len < WORD_INLINE ? 0 : len + 1);
+}
+
+/* Fills a word structure at pWord (freq = 1)
+	return	pWord
+*/
+tWord *initWord( void *pWord, const char *word, size_t len){
+	tWord *p = pWord;
+	char *str = len < WORD_INLINE ? p -> word.str : (char *)(p + 1);
+
+	p -> freq = 1;
+	p -> len = (int)len;
+	if(len >= WORD_INLINE) p -> word.ptr = str;
+
+	// word 는 '\0' 으로 끝나지 않을 수 있으므로 len 바이트만 복사
+	memcpy(str, word, len);
+	str[len] = '\0';
+	return p;
+}
+
+/* Releases a word structure (callback for destroyList, destroyHash)
+*/
+void destroyWord( void *pWord){
+	free(pWord);
+}
+
+/* returns word string stored in the word structure
+*/
+char *get_word( const tWord *pWord){
+	return pWord -> len < WORD_INLINE ? (char *)pWord -> word.str : pWord -> word.ptr;
+}
+
+/* Fills a key structure for searching (짧은 단어만 복사, 긴 단어는 word 를 그대로 가리킴)
+*/
+void set_key( tWord *pKey, char *word){
+	set_key_len(pKey, word, strlen(word));
+}
+
+/* Fills a key structure for searching from a (pointer, length) span
+	짧은 단어는 복사해서 '\0' 을 붙이고, 긴 단어는 word 를 그대로 가리킴 ('\0' 없음)
+*/
+void set_key_len( tWord *pKey, const char *word, size_t len){
+	pKey -> freq = 0;
+	pKey -> len = (int)len;
+	if(len < WORD_INLINE){
+		memcpy(pKey -> word.str, word, len);
+		pKey -> word.str[len] = '\0';
+	}
+	else{
+		pKey -> word.ptr = (char *)word;
+	}
+}
+
+/* compares two words in word structures (strcmp 와 같은 순서)
+	길이를 알고 있으므로 memcmp 로 공통 부분을 비교하고, 같으면 짧은 단어가 앞
+*/
+int compare_by_word( const void *n1, const void *n2){
+	const tWord *p1 = n1;
+	const tWord *p2 = n2;
+	int len = p1 -> len < p2 -> len ? p1 -> len : p2 -> len;
+
+	int ret = memcmp(get_word(p1), get_word(p2), len);
+	if(ret != 0) return ret;
+
+	return p1 -> len - p2 -> len;
+}
+
+/* compares two words by frequency (빈도 내림차순, 같으면 compare_by_word 순서)
+*/
+int compare_by_freq( const void *n1, const void *n2){
+	const tWord *p1 = n1;
+	const tWord *p2 = n2;
+
+	if(p1 -> freq != p2 -> freq) return p1 -> freq > p2 -> freq ? -1 : 1;
+	return compare_by_word(p1, p2);
+}
+
+/* returns first 8 bytes of the word as a big-endian integer (compare_by_word 순서를 유지)
+	단어 뒤는 0 으로 채우므로 공통 부분이 같으면 짧은 단어가 작음
+*/
+uint64_t word_prefix( const void *pWord){
+	const tWord *p = pWord;
+	const unsigned char *s = (const unsigned char *)get_word(p);
+	uint64_t prefix = 0;
+
+	for(int i = 0; i < 8; i++){
+		prefix = prefix << 8 | (i < p -> len ? s[i] : 0);
+	}
+	return prefix;
+}
@@ -0,0 +1,78 @@
+#ifndef WORD_H
+#define WORD_H
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+
+////////////////////////////////////////////////////////////////////////////////
+// tWord type definition
+// 단어 구조체 (adt_dlist, adt_hash, assignment_2/3 사전의 dataPtr 로 사용)
+// 짧은 단어(WORD_INLINE 바이트 미만)는 구조체 안에 직접 저장해서 비교할 때 포인터를 한 번 덜 따라감
+// 긴 단어만 구조체 바로 뒤(같은 할당)에 저장하고 word.ptr 로 가리킴
+#define WORD_INLINE	16
+
+typedef struct
+{
+	int		freq;	// 빈도
+	int		len;	// 단어 길이 ('\0' 제외)
+	union
+	{
+		char	str[WORD_INLINE];	// len < WORD_INLINE 인 단어 ('\0' 포함)
+		char	*ptr;				// 긴 단어
+	} word;
+} tWord;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a word structure (freq = 1)
+	return	word structure pointer
+			NULL if overflow
+*/
+tWord *createWord( char *word);
+
+/* returns size of a word structure holding a word of len bytes ('\0' 제외)
+	긴 단어는 문자열을 구조체 바로 뒤에 저장하므로 그만큼 더 큼
+*/
+size_t word_size( size_t len);
+
+/* Fills a word structure at pWord (freq = 1)
+	pWord	word_size(len) 바이트 메모리 (아레나처럼 malloc 이 아닌 곳에 단어를 만들 때)
+	word	len 바이트 단어 ('\0' 으로 끝나지 않아도 됨, 복사본에는 '\0' 을 붙임)
+	return	pWord
+*/
+tWord *initWord( void *pWord, const char *word, size_t len);
+
+/* Releases a word structure (callback for destroyList, destroyHash)
+*/
+void destroyWord( void *pWord);
+
+/* returns word string stored in the word structure
+*/
+char *get_word( const tWord *pWord);
+
+/* Fills a key structure for searching (짧은 단어만 복사, 긴 단어는 word 를 그대로 가리킴)
+*/
+void set_key( tWord *pKey, char *word);
+
+/* Fills a key structure for searching from a (pointer, length) span (nextToken 의 단어)
+	긴 단어는 '\0' 으로 끝나지 않는 word 를 그대로 가리키므로 get_word 로 출력하지 말 것
+	(compare_by_word, compare_by_freq, word_prefix, initWord 는 len 만큼만 읽음)
+*/
+void set_key_len( tWord *pKey, const char *word, size_t len);
+
+/* compares two words in word structures (strcmp 와 같은 순서)
+*/
+int compare_by_word( const void *n1, const void *n2);
+
+/* compares two words by frequency (빈도 내림차순, 같으면 compare_by_word 순서)
+	topList 의 order 로 사용
+*/
+int compare_by_freq( const void *n1, const void *n2);
+
+/* returns first 8 bytes of the word as a big-endian integer (compare_by_word 순서를 유지)
+	adt_dlist 의 setPrefix 에 사용
+*/
+uint64_t word_prefix( const void *pWord);
+
+#endif